@@ -11,11 +11,55 @@ AntAlgorithm::AntAlgorithm(const s21::Matrix<double> &graph, int count = 1)
 
 TsmResult AntAlgorithm::GetResult(bool isMultithreading = false) {
   error_ = CheckGraph_();
+  cancelled_ = false;
   if (error_ == GraphError::GRAPH_NORMAL || error_ == GraphError::GRAPH_DIRECT)
     PreparingForExecution_(isMultithreading);
   return result_;
 }
 
+TsmResult AntAlgorithm::GetResultWithParallelism(int number_of_thread) {
+  error_ = CheckGraph_();
+  cancelled_ = false;
+  if (error_ == GraphError::GRAPH_NORMAL ||
+      error_ == GraphError::GRAPH_DIRECT) {
+    SetStartingValueForPheromones_();
+    ParallelExecution_(number_of_thread < 1 ? 1 : number_of_thread);
+  }
+  return result_;
+}
+
+TsmResult AntAlgorithm::GetResultAutotuned() {
+  error_ = CheckGraph_();
+  if (error_ != GraphError::GRAPH_NORMAL && error_ != GraphError::GRAPH_DIRECT)
+    return result_;
+  std::vector<TunedConfig> candidates{{0, 1, 0, 0}};
+  for (int threads : Autotuner::ThreadCandidates())
+    candidates.push_back({1, threads, 0, 0});
+  //  The trial colonies run without the token, the final run gets it
+  TunedConfig best = Autotuner::Select(
+      Autotuner::MakeKey("ant", {size_}), candidates,
+      [this](const TunedConfig &config) {
+        AntAlgorithm trial(graph_, 1);
+        trial.iterations_ = kTrialIterations;
+        TsmResult found;
+        double seconds = Autotuner::Time([&]() {
+          found = config.variant == 0
+                      ? trial.GetResult(false)
+                      : trial.GetResultWithParallelism(config.threads);
+        });
+        if (found.distance < result_.distance) result_ = found;
+        return seconds;
+      });
+  return best.variant == 0 ? GetResult(false)
+                           : GetResultWithParallelism(best.threads);
+}
+
+bool AntAlgorithm::Cancelled_() {
+  if (!token_.IsCancelled()) return false;
+  cancelled_ = true;
+  return true;
+}
+
 GraphError AntAlgorithm::CheckGraph_() {
   if (graph_.GetRows() < 3) return GraphError::GRAPH_SMALL;
   for (auto row = 0; row < graph_.GetRows(); row++) {
@@ -32,28 +76,48 @@ GraphError AntAlgorithm::CheckGraph_() {
 void AntAlgorithm::PreparingForExecution_(bool isMultithreading) {
   SetStartingValueForPheromones_();
   if (isMultithreading) {
-    thread th1(&AntAlgorithm::StartIteration_, this, 250);
-    thread th2(&AntAlgorithm::StartIteration_, this, 250);
-    thread th3(&AntAlgorithm::StartIteration_, this, 250);
-    thread th4(&AntAlgorithm::StartIteration_, this, 250);
+    vector<int> placement = Topology::Get().Placement(4);
+    thread th1 = Topology::StartThread(
+        placement[0], &AntAlgorithm::StartIteration_, this, iterations_ / 4);
+    thread th2 = Topology::StartThread(
+        placement[1], &AntAlgorithm::StartIteration_, this, iterations_ / 4);
+    thread th3 = Topology::StartThread(
+        placement[2], &AntAlgorithm::StartIteration_, this, iterations_ / 4);
+    thread th4 = Topology::StartThread(
+        placement[3], &AntAlgorithm::StartIteration_, this, iterations_ / 4);
     th1.join();
     th2.join();
     th3.join();
     th4.join();
   } else {
-    StartIteration_(1000);
+    StartIteration_(iterations_);
+  }
+}
+
+void AntAlgorithm::ParallelExecution_(int number_of_thread) {
+  vector<int> placement = Topology::Get().Placement(number_of_thread);
+  vector<thread> threads(number_of_thread);
+  for (int i = 0; i < number_of_thread; i++) {
+    int end = iterations_ * (i + 1) / number_of_thread -
+              iterations_ * i / number_of_thread;
+    threads[i] = Topology::StartThread(
+        placement[i], &AntAlgorithm::StartIteration_, this, end);
   }
+  for (int i = 0; i < number_of_thread; i++) threads[i].join();
 }
 
 void AntAlgorithm::StartIteration_(int end) {
-  for (int i = 0; i < count_; i++) {
+  for (int i = 0; i < count_ && !(i > 0 && Cancelled_()); i++) {
+    S21_TRACE_SCOPE("ant iteration");
     if (i > 0) UpdatePheromones_();
     AlgorithmExecution_(end);
   }
 }
 
 void AntAlgorithm::AlgorithmExecution_(int end) {
+  S21_TRACE_SCOPE("ant tours");
   for (int i = 0; i < end; i++) {
+    if (i > 0 && Cancelled_()) return;
     for (auto ant = 0; ant < size_; ant++) {
       int position = 0;
       vector<int> visited;
@@ -67,10 +131,12 @@ void AntAlgorithm::AlgorithmExecution_(int end) {
       }
       IncreaseDelta_(visited);
       int cost = GetCostPath_(visited);
+      S21_TRACE_LOCK(mutex_, "ant best tour lock");
       if (result_.distance > cost) {
         result_.distance = cost;
         result_.vertices = GetRightVertices_(visited);
       }
+      mutex_.unlock();
     }
   }
 }
@@ -115,7 +181,7 @@ int AntAlgorithm::GetNextPosition_(map<int, double> &probability) {
 void AntAlgorithm::IncreaseDelta_(const vector<int> &visited) {
   const double q = 10.0;
   int prev_point = visited[0], sum = GetCostPath_(visited);
-  mutex_.lock();
+  S21_TRACE_LOCK(mutex_, "ant delta lock");
   for (unsigned long i = 1; i < visited.size(); i++) {
     pheromones_delta_(prev_point, visited[i]) += q / (double)sum;
   }
@@ -123,8 +189,9 @@ void AntAlgorithm::IncreaseDelta_(const vector<int> &visited) {
 }
 
 void AntAlgorithm::UpdatePheromones_() {
+  S21_TRACE_SCOPE("ant pheromone update");
   for (auto row = 0; row < size_; row++) {
-    mutex_.lock();
+    S21_TRACE_LOCK(mutex_, "ant pheromone lock");
     for (auto col = 0; col < size_; col++) {
       pheromones_(row, col) =
           pheromones_(row, col) * 0.64 + pheromones_delta_(row, col);
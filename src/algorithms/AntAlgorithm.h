@@ -1,6 +1,7 @@
 #ifndef SRC_ALGORITHMS_ANTALGORITHM_H
 #define SRC_ALGORITHMS_ANTALGORITHM_H
 
+#include <atomic>
 #include <climits>
 #include <map>
 #include <mutex>
@@ -8,7 +9,11 @@
 #include <utility>
 #include <vector>
 
+#include "../helpers/autotuner.h"
+#include "../helpers/cancellation.h"
 #include "../helpers/matrix.h"
+#include "../helpers/topology.h"
+#include "../helpers/trace.h"
 
 using std::map;
 using std::thread;
@@ -35,19 +40,39 @@ class AntAlgorithm {
   explicit AntAlgorithm(const Matrix<double> &graph, int count);
   ~AntAlgorithm() = default;
   TsmResult GetResult(bool isMultithreading);
+  //  The kIterations iterations are split between number_of_thread colonies
+  TsmResult GetResultWithParallelism(int number_of_thread);
+  //  Serial or parallel with the thread count the Autotuner found fastest
+  //  for this graph size. Tuning runs are single colonies of
+  //  kTrialIterations iterations on copies of the graph, the best tour any
+  //  of them found is kept.
+  TsmResult GetResultAutotuned();
+  //  Polled before every iteration after the first, so a cancelled or
+  //  timed out colony still returns the best tour found so far
+  void SetCancellation(CancellationToken token) { token_ = std::move(token); }
   GraphError GetError() { return error_; }
+  bool GetCancelled() { return cancelled_; }
+
+  //  Iterations of one colony, every one sends out size ants
+  static constexpr int kIterations = 1000;
+  static constexpr int kTrialIterations = 100;
 
  private:
   TsmResult result_;
   Matrix<double> graph_;
   std::mutex mutex_;
   int size_, count_;
+  int iterations_ = kIterations;
   Matrix<double> pheromones_;
   Matrix<double> pheromones_delta_;
   GraphError error_ = GraphError::GRAPH_NORMAL;
+  CancellationToken token_;
+  std::atomic<bool> cancelled_{false};
 
+  bool Cancelled_();
   GraphError CheckGraph_();
   void PreparingForExecution_(bool isMultithreading);
+  void ParallelExecution_(int number_of_thread);
   void StartIteration_(int end);
   void AlgorithmExecution_(int end);
   void SetStartingValueForPheromones_();
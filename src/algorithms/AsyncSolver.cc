@@ -0,0 +1,106 @@
+#include "AsyncSolver.h"
+
+namespace s21 {
+AsyncSolver::AsyncSolver(int workers) {
+  if (workers < 1) workers = Topology::Get().GetMaxThreads();
+  std::vector<int> placement = Topology::Get().Placement(workers);
+  for (int i = 0; i < workers; ++i)
+    workers_.push_back(
+        Topology::StartThread(placement[i], &AsyncSolver::WorkerLoop_, this));
+}
+
+AsyncSolver::~AsyncSolver() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+    for (Task &task : queue_) task.token.Cancel();
+  }
+  cv_.notify_all();
+  for (std::thread &worker : workers_) worker.join();
+}
+
+//  The queue is drained before the workers leave, cancelled jobs return at
+//  their first cancellation point so every future is fulfilled
+void AsyncSolver::WorkerLoop_() {
+  while (true) {
+    Task task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+      if (queue_.empty()) return;
+      task = std::move(queue_.front());
+      queue_.pop_front();
+    }
+    task.run();
+  }
+}
+
+AsyncStatus AsyncSolver::GetCancelledStatus_(const CancellationToken &token) {
+  return token.GetReason() == DEADLINE_EXCEEDED ? ASYNC_DEADLINE_EXCEEDED
+                                                : ASYNC_CANCELLED;
+}
+
+AsyncJob<Matrix<double>> AsyncSolver::Multiply(
+    Matrix<double> first, Matrix<double> second, ExecutionType type,
+    AsyncOptions options, Callback<Matrix<double>> callback) {
+  auto run = [first = std::move(first), second = std::move(second), type,
+              threads = options.threads](const CancellationToken &token) {
+    AsyncResult<Matrix<double>> result;
+    WinogradAlgorithm<double> algorithm(first, second);
+    algorithm.SetCancellation(token);
+    result.value = algorithm.GetResultMatrix(type, threads);
+    if (algorithm.GetCancelled()) {
+      result.status = GetCancelledStatus_(token);
+    } else if (algorithm.GetError()) {
+      result.status = ASYNC_FAILED;
+      result.error = "incorrect matrix size";
+    }
+    return result;
+  };
+  return Submit_<Matrix<double>>(options, std::move(run), std::move(callback));
+}
+
+AsyncJob<std::vector<double>> AsyncSolver::Solve(
+    Matrix<double> system, AsyncOptions options,
+    Callback<std::vector<double>> callback) {
+  auto run = [system = std::move(system), threads = options.threads](
+                 const CancellationToken &token) mutable {
+    AsyncResult<std::vector<double>> result;
+    if (!GaussAlgorithm::CheckGaussMatrix(system)) {
+      result.status = ASYNC_FAILED;
+      result.error = "incorrect system of equations";
+      return result;
+    }
+    result.value =
+        threads > 1
+            ? GaussAlgorithm::GaussWithParallelism(system, threads, token)
+            : GaussAlgorithm::GaussWithoutParallelism(system, token);
+    if (result.value.empty()) result.status = GetCancelledStatus_(token);
+    return result;
+  };
+  return Submit_<std::vector<double>>(options, std::move(run),
+                                      std::move(callback));
+}
+
+AsyncJob<TsmResult> AsyncSolver::Tsp(Matrix<double> graph,
+                                     AsyncOptions options,
+                                     Callback<TsmResult> callback) {
+  auto run = [graph = std::move(graph),
+              threads = options.threads](const CancellationToken &token) {
+    AsyncResult<TsmResult> result;
+    AntAlgorithm algorithm(graph, 1);
+    algorithm.SetCancellation(token);
+    result.value = threads > 1 ? algorithm.GetResultWithParallelism(threads)
+                               : algorithm.GetResult(false);
+    GraphError error = algorithm.GetError();
+    if (error == GRAPH_SMALL || error == GRAPH_INCOMPLETE) {
+      result.status = ASYNC_FAILED;
+      result.error = "graph can't be incomplete or smaller than 3x3";
+    } else if (algorithm.GetCancelled()) {
+      result.status = GetCancelledStatus_(token);
+    }
+    return result;
+  };
+  return Submit_<TsmResult>(options, std::move(run), std::move(callback));
+}
+}  // namespace s21
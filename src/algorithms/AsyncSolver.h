@@ -0,0 +1,151 @@
+#ifndef SRC_ALGORITHMS_ASYNCSOLVER_H
+#define SRC_ALGORITHMS_ASYNCSOLVER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../helpers/cancellation.h"
+#include "../helpers/matrix.h"
+#include "AntAlgorithm.h"
+#include "GaussAlgorithm.h"
+#include "WinogradAlgorithm.h"
+
+namespace s21 {
+
+enum AsyncStatus {
+  ASYNC_DONE,
+  ASYNC_FAILED,
+  ASYNC_CANCELLED,
+  ASYNC_DEADLINE_EXCEEDED
+};
+
+//  value is empty unless status is ASYNC_DONE, except for a tour: a
+//  cancelled or timed out colony still hands back its best tour
+template <class T>
+struct AsyncResult {
+  T value{};
+  AsyncStatus status = ASYNC_DONE;
+  std::string error;
+};
+
+struct AsyncOptions {
+  int threads = 1;  //  of the algorithm itself, 1 runs it serially
+  //  Counted from submission, so time spent queued is included. Zero
+  //  means no deadline.
+  std::chrono::steady_clock::duration timeout{0};
+};
+
+template <class T>
+class AsyncJob {
+ public:
+  AsyncJob(std::future<AsyncResult<T>> future, CancellationToken token)
+      : future_(std::move(future)), token_(std::move(token)) {}
+
+  //  The job stops at its next cancellation point, Get() still returns
+  void Cancel() const { token_.Cancel(); }
+  AsyncResult<T> Get() { return future_.get(); }
+  bool IsReady() const {
+    return future_.wait_for(std::chrono::seconds(0)) ==
+           std::future_status::ready;
+  }
+  template <class Rep, class Period>
+  bool WaitFor(std::chrono::duration<Rep, Period> timeout) const {
+    return future_.wait_for(timeout) == std::future_status::ready;
+  }
+  const CancellationToken &GetToken() const { return token_; }
+
+ private:
+  std::future<AsyncResult<T>> future_;
+  CancellationToken token_;
+};
+
+//  Runs multiplications, systems and tours on a fixed pool of workers and
+//  returns at once. The result arrives through the future of the returned
+//  AsyncJob and, if given, a callback that is called on the worker before
+//  the future becomes ready, anything it throws is dropped. Every job has
+//  its own CancellationToken, polled per pivot, per result row and per
+//  colony iteration. Jobs still queued when the solver is destroyed are
+//  cancelled, running ones are waited for. Workers are placed by Topology
+//  like the other pools. Jobs on different workers share nothing but the
+//  mutex guarded Topology, Autotuner and allocator state, the kernels
+//  keep their working state per call.
+class AsyncSolver {
+ public:
+  template <class T>
+  using Callback = std::function<void(const AsyncResult<T> &)>;
+
+  explicit AsyncSolver(int workers = 0);  //  0 takes GetMaxThreads()
+  ~AsyncSolver();
+  AsyncSolver(const AsyncSolver &) = delete;
+  AsyncSolver &operator=(const AsyncSolver &) = delete;
+
+  AsyncJob<Matrix<double>> Multiply(
+      Matrix<double> first, Matrix<double> second,
+      ExecutionType type = WITHOUT_PARALLELISM, AsyncOptions options = {},
+      Callback<Matrix<double>> callback = nullptr);
+  AsyncJob<std::vector<double>> Solve(
+      Matrix<double> system, AsyncOptions options = {},
+      Callback<std::vector<double>> callback = nullptr);
+  AsyncJob<TsmResult> Tsp(Matrix<double> graph, AsyncOptions options = {},
+                          Callback<TsmResult> callback = nullptr);
+  [[nodiscard]] int GetWorkerCount() const { return (int)workers_.size(); }
+
+ private:
+  struct Task {
+    CancellationToken token;
+    std::function<void()> run;
+  };
+
+  std::vector<std::thread> workers_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<Task> queue_;
+  bool stopping_ = false;
+
+  void WorkerLoop_();
+  static AsyncStatus GetCancelledStatus_(const CancellationToken &token);
+
+  template <class T>
+  AsyncJob<T> Submit_(
+      const AsyncOptions &options,
+      std::function<AsyncResult<T>(const CancellationToken &)> run,
+      Callback<T> callback) {
+    CancellationToken token = CancellationToken::Create();
+    if (options.timeout.count() > 0) token.SetTimeout(options.timeout);
+    auto promise = std::make_shared<std::promise<AsyncResult<T>>>();
+    AsyncJob<T> job(promise->get_future(), token);
+    Task task{token, [token, promise, run = std::move(run),
+                      callback = std::move(callback)]() {
+                AsyncResult<T> result;
+                try {
+                  result = run(token);
+                } catch (std::exception &exception) {
+                  result.status = ASYNC_FAILED;
+                  result.error = exception.what();
+                }
+                //  A throwing callback must not leave the future unset
+                try {
+                  if (callback) callback(result);
+                } catch (...) {
+                }
+                promise->set_value(std::move(result));
+              }};
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      queue_.push_back(std::move(task));
+    }
+    cv_.notify_one();
+    return job;
+  }
+};
+}  // namespace s21
+
+#endif  //  SRC_ALGORITHMS_ASYNCSOLVER_H
@@ -0,0 +1,163 @@
+#include "BandedGaussAlgorithm.h"
+
+#include <cmath>
+
+namespace s21 {
+
+std::vector<double> BandedGaussAlgorithm::SolveAugmented(
+    Matrix<double> &matrix, int lower, int upper, int number_of_thread) {
+  int size = matrix.GetRows();
+  if (size < 1 || matrix.GetCols() != size + 1) return {};
+  if (lower > 1 || upper > 1) return SolveBanded(matrix, lower, upper);
+
+  std::vector<double> sub(size, 0), diagonal(size), super(size, 0),
+      right(size);
+  for (int i = 0; i < size; ++i) {
+    const double *row = matrix.GetRow(i);
+    if (i > 0) sub[i] = row[i - 1];
+    diagonal[i] = row[i];
+    if (i < size - 1) super[i] = row[i + 1];
+    right[i] = row[size];
+  }
+  if (size >= kCyclicReductionMinRows && number_of_thread > 1)
+    return SolveCyclicReduction(std::move(sub), std::move(diagonal),
+                                std::move(super), std::move(right),
+                                number_of_thread);
+  return SolveTridiagonal(std::move(sub), std::move(diagonal),
+                          std::move(super), std::move(right));
+}
+
+//  lower[0] and upper[n - 1] are ignored
+std::vector<double> BandedGaussAlgorithm::SolveTridiagonal(
+    std::vector<double> lower, std::vector<double> diagonal,
+    std::vector<double> upper, std::vector<double> right) {
+  int size = (int)diagonal.size();
+  for (int i = 0; i < size; ++i) {
+    if (diagonal[i] == 0) return {};
+    if (i + 1 < size) {
+      double factor = lower[i + 1] / diagonal[i];
+      diagonal[i + 1] -= factor * upper[i];
+      right[i + 1] -= factor * right[i];
+    }
+  }
+  std::vector<double> result(size);
+  for (int i = size - 1; i >= 0; --i) {
+    double sum = right[i];
+    if (i + 1 < size) sum -= upper[i] * result[i + 1];
+    result[i] = sum / diagonal[i];
+  }
+  return result;
+}
+
+std::vector<double> BandedGaussAlgorithm::SolveCyclicReduction(
+    std::vector<double> lower, std::vector<double> diagonal,
+    std::vector<double> upper, std::vector<double> right,
+    int number_of_thread) {
+  Tridiagonal system{std::move(lower), std::move(diagonal), std::move(upper),
+                     std::move(right), {}, 0};
+  system.size = (int)system.diagonal.size();
+  if (system.size < 1) return {};
+  system.lower[0] = 0;
+  system.upper[system.size - 1] = 0;
+  system.result.assign(system.size, 0);
+  if (number_of_thread < 1) number_of_thread = 1;
+
+  Barrier barrier(number_of_thread);
+  std::vector<int> placement = Topology::Get().Placement(number_of_thread);
+  std::vector<std::thread> threads;
+  for (int i = 1; i < number_of_thread; ++i) {
+    threads.push_back(Topology::StartThread(placement[i], ReduceLevels_,
+                                            std::ref(system), i,
+                                            number_of_thread,
+                                            std::ref(barrier)));
+  }
+  ReduceLevels_(system, 0, number_of_thread, barrier);
+  for (auto &th : threads) th.join();
+
+  for (double value : system.result)
+    if (!std::isfinite(value)) return {};
+  return system.result;
+}
+
+//  Level s eliminates the neighbours i - s and i + s from every equation
+//  i = 2s - 1 (mod 2s). Equations of one level are independent and are
+//  split between the threads, the levels are separated by barriers.
+void BandedGaussAlgorithm::ReduceLevels_(Tridiagonal &system, int thread_id,
+                                         int number_of_thread,
+                                         Barrier &barrier) {
+  int size = system.size, top = 1;
+  std::vector<double> &a = system.lower, &b = system.diagonal,
+                      &c = system.upper, &d = system.right,
+                      &x = system.result;
+  for (int step = 1; step < size; step *= 2) {
+    int count = size > 2 * step - 1 ? (size - 2 * step) / (2 * step) + 1 : 0;
+    for (int m = thread_id * count / number_of_thread;
+         m < (thread_id + 1) * count / number_of_thread; ++m) {
+      int i = 2 * step - 1 + m * 2 * step, low = i - step, high = i + step;
+      double alpha = -a[i] / b[low];
+      double gamma = high < size ? -c[i] / b[high] : 0;
+      a[i] = alpha * a[low];
+      b[i] += alpha * c[low] + (high < size ? gamma * a[high] : 0);
+      d[i] += alpha * d[low] + (high < size ? gamma * d[high] : 0);
+      c[i] = high < size ? gamma * c[high] : 0;
+    }
+    barrier.Wait();
+    if (2 * step <= size) top = 2 * step;
+  }
+  for (int step = top; step >= 1; step /= 2) {
+    int count = size > step - 1 ? (size - step) / (2 * step) + 1 : 0;
+    for (int m = thread_id * count / number_of_thread;
+         m < (thread_id + 1) * count / number_of_thread; ++m) {
+      int i = step - 1 + m * 2 * step;
+      double sum = d[i];
+      if (i - step >= 0) sum -= a[i] * x[i - step];
+      if (i + step < size) sum -= c[i] * x[i + step];
+      x[i] = sum / b[i];
+    }
+    barrier.Wait();
+  }
+}
+
+//  Row i keeps the columns i - lower .. i + upper, so element (i, j) is
+//  stored at i * width + j - i + lower
+std::vector<double> BandedGaussAlgorithm::SolveBanded(Matrix<double> &matrix,
+                                                      int lower, int upper) {
+  int size = matrix.GetRows();
+  if (size < 1 || matrix.GetCols() != size + 1 || lower < 0 || upper < 0)
+    return {};
+  int width = lower + upper + 1;
+  std::vector<double> band((size_t)size * width, 0), right(size);
+  for (int i = 0; i < size; ++i) {
+    const double *row = matrix.GetRow(i);
+    int start = i - lower < 0 ? 0 : i - lower;
+    int end = i + upper >= size ? size - 1 : i + upper;
+    for (int j = start; j <= end; ++j)
+      band[(size_t)i * width + j - i + lower] = row[j];
+    right[i] = row[size];
+  }
+  auto at = [&band, width, lower](int i, int j) -> double & {
+    return band[(size_t)i * width + j - i + lower];
+  };
+
+  for (int k = 0; k < size; ++k) {
+    double pivot = at(k, k);
+    if (pivot == 0) return {};
+    int last_row = k + lower >= size ? size - 1 : k + lower;
+    int last_col = k + upper >= size ? size - 1 : k + upper;
+    for (int i = k + 1; i <= last_row; ++i) {
+      double factor = at(i, k) / pivot;
+      if (factor == 0) continue;
+      for (int j = k + 1; j <= last_col; ++j) at(i, j) -= factor * at(k, j);
+      right[i] -= factor * right[k];
+    }
+  }
+  std::vector<double> result(size);
+  for (int i = size - 1; i >= 0; --i) {
+    int last_col = i + upper >= size ? size - 1 : i + upper;
+    double sum = right[i];
+    for (int j = i + 1; j <= last_col; ++j) sum -= at(i, j) * result[j];
+    result[i] = sum / at(i, i);
+  }
+  return result;
+}
+}  // namespace s21
@@ -0,0 +1,48 @@
+#ifndef SRC_ALGORITHMS_BANDEDGAUSSALGORITHM_H
+#define SRC_ALGORITHMS_BANDEDGAUSSALGORITHM_H
+
+#include <thread>
+#include <vector>
+
+#include "../helpers/barrier.h"
+#include "../helpers/matrix.h"
+#include "../helpers/topology.h"
+
+namespace s21 {
+//  Solvers for systems whose non-zero coefficients lie in a narrow band
+//  around the diagonal: the Thomas algorithm for tridiagonal systems,
+//  cyclic reduction spread over threads for very long tridiagonal ones and
+//  LU in compact band storage otherwise. Everything runs in O(n * b^2)
+//  time and O(n * b) memory. Like GaussAlgorithm no pivoting is done, a
+//  zero pivot makes the solvers return an empty vector.
+class BandedGaussAlgorithm {
+ public:
+  //  Tridiagonal systems from this size on use cyclic reduction
+  static constexpr int kCyclicReductionMinRows = 1 << 16;
+
+  static std::vector<double> SolveAugmented(Matrix<double> &matrix,
+                                            int lower, int upper,
+                                            int number_of_thread = 1);
+  static std::vector<double> SolveTridiagonal(std::vector<double> lower,
+                                              std::vector<double> diagonal,
+                                              std::vector<double> upper,
+                                              std::vector<double> right);
+  static std::vector<double> SolveCyclicReduction(
+      std::vector<double> lower, std::vector<double> diagonal,
+      std::vector<double> upper, std::vector<double> right,
+      int number_of_thread);
+  static std::vector<double> SolveBanded(Matrix<double> &matrix, int lower,
+                                         int upper);
+
+ private:
+  struct Tridiagonal {
+    std::vector<double> lower, diagonal, upper, right, result;
+    int size;
+  };
+
+  static void ReduceLevels_(Tridiagonal &system, int thread_id,
+                            int number_of_thread, Barrier &barrier);
+};
+}  // namespace s21
+
+#endif  // SRC_ALGORITHMS_BANDEDGAUSSALGORITHM_H
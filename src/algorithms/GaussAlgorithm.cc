@@ -1,81 +1,189 @@
 #include "GaussAlgorithm.h"
 
 namespace s21 {
-int GaussAlgorithm::threads_in_level_;
+//  One thread of the machine is left to the caller, which only waits
+int GaussAlgorithm::GetNumberOfThreads(const Matrix<double> &matrix) {
+  int number_of_thread = Topology::Get().GetMaxThreads() - 1;
+  if (number_of_thread > matrix.GetCols()) number_of_thread = matrix.GetCols();
+  return number_of_thread < 1 ? 1 : number_of_thread;
+}
+
+std::vector<double> GaussAlgorithm::GaussWithoutParallelism(
+    Matrix<double> &matrix, const CancellationToken &token) {
+  return GaussWithoutParallelism(matrix, MatrixStructure(), token);
+}
+
+std::vector<double> GaussAlgorithm::GaussWithParallelism(
+    Matrix<double> &matrix, int number_of_thread,
+    const CancellationToken &token) {
+  return GaussWithParallelism(matrix, MatrixStructure(), number_of_thread,
+                              token);
+}
 
 std::vector<double> GaussAlgorithm::GaussWithoutParallelism(
-    Matrix<double> &matrix) {
+    Matrix<double> &matrix, const MatrixStructure &structure,
+    const CancellationToken &token) {
   std::vector<double> result(matrix.GetRows());
-  if (CheckGaussMatrix(matrix)) {
-    double tmp;
-    for (int i = 0; i < matrix.GetRows(); ++i) {
-      tmp = matrix(i, i);
-      for (int j = matrix.GetRows(); j >= i; --j) {
-        matrix(i, j) /= tmp;
-      }
+  if (token.IsCancelled()) return {};
+  if (!CheckGaussMatrix(matrix) || SolveIfSmall_(matrix, result))
+    return result;
+  MatrixStructure known = GetStructure_(matrix, structure);
+  if (!SolveIfBanded_(matrix, known, result, 1) &&
+      !SolveIfSparse_(matrix, known, result))
+    result = GaussWithoutParallelism(MatrixView<double>(matrix), token);
+  return result;
+}
 
-      for (int j = i + 1; j < matrix.GetRows(); ++j) {
-        tmp = matrix(j, i);
-        for (int k = matrix.GetRows(); k >= i; --k) {
-          matrix(j, k) -= tmp * matrix(i, k);
-        }
+std::vector<double> GaussAlgorithm::GaussWithoutParallelism(
+    MatrixView<double> system, const CancellationToken &token) {
+  int rows = system.GetRows();
+  std::vector<double> result(rows);
+  if (token.IsCancelled()) return {};
+  if (rows < 2 || system.GetCols() != rows + 1) return result;
+  double tmp;
+  for (int i = 0; i < rows; ++i) {
+    if (token.IsCancelled()) return {};
+    double *pivot_row = system.GetRow(i);
+    tmp = pivot_row[i];
+    for (int j = rows; j >= i; --j) {
+      pivot_row[j] /= tmp;
+    }
+
+    for (int j = i + 1; j < rows; ++j) {
+      double *row = system.GetRow(j);
+      tmp = row[i];
+      for (int k = rows; k >= i; --k) {
+        row[k] -= tmp * pivot_row[k];
       }
     }
+  }
 
-    result[matrix.GetRows() - 1] =
-        matrix(matrix.GetRows() - 1, matrix.GetRows());
+  result[rows - 1] = system(rows - 1, rows);
 
-    for (int i = matrix.GetRows() - 2; i >= 0; --i) {
-      result[i] = matrix(i, matrix.GetRows());
-      for (int j = i + 1; j < matrix.GetRows(); ++j) {
-        result[i] -= matrix(i, j) * result[j];
-      }
+  for (int i = rows - 2; i >= 0; --i) {
+    const double *row = system.GetRow(i);
+    result[i] = row[rows];
+    for (int j = i + 1; j < rows; ++j) {
+      result[i] -= row[j] * result[j];
     }
   }
   return result;
 }
 
+std::vector<double> GaussAlgorithm::GaussSparse(
+    const SparseMatrix<double> &matrix, const std::vector<double> &right,
+    const CancellationToken &token) {
+  int size = matrix.GetRows();
+  if (token.IsCancelled()) return {};
+  if (size < 2 || matrix.GetCols() != size || (int)right.size() != size)
+    return std::vector<double>(size);
+  if (size >= kSparseMinRows) {
+    std::vector<double> result = SparseGaussAlgorithm::Solve(matrix, right);
+    if (!result.empty()) return result;
+  }
+  Matrix<double> system(size, size + 1);
+  const std::vector<int> &row_start = matrix.GetRowStart();
+  const std::vector<int> &col_index = matrix.GetColIndex();
+  const std::vector<double> &values = matrix.GetValues();
+  for (int i = 0; i < size; ++i) {
+    double *row = system.GetRow(i);
+    for (int k = row_start[i]; k < row_start[i + 1]; ++k)
+      row[col_index[k]] = values[k];
+    row[size] = right[i];
+  }
+  if (size >= kSparseMinRows)
+    return GaussWithoutParallelism(MatrixView<double>(system), token);
+  return GaussWithoutParallelism(system, token);
+}
+
+//  number_of_thread < 1 picks GetNumberOfThreads(matrix)
 std::vector<double> GaussAlgorithm::GaussWithParallelism(
-    Matrix<double> &matrix) {
+    Matrix<double> &matrix, const MatrixStructure &structure,
+    int number_of_thread, const CancellationToken &token) {
   std::vector<double> result_;
-  if (CheckGaussMatrix(matrix)) {
-    threads_in_level_ = std::thread::hardware_concurrency() - 1;
-    threads_in_level_ = matrix.GetCols() < threads_in_level_
-                            ? matrix.GetCols()
-                            : threads_in_level_;
-    result_.reserve(matrix.GetRows());
+  if (token.IsCancelled() || !CheckGaussMatrix(matrix)) return result_;
+  if (number_of_thread < 1) number_of_thread = GetNumberOfThreads(matrix);
+  MatrixStructure known = GetStructure_(matrix, structure);
+  if (!SolveIfBanded_(matrix, known, result_, number_of_thread) &&
+      !SolveIfSparse_(matrix, known, result_)) {
+    ThreadLevel level;
+    level.threads = number_of_thread < matrix.GetCols() ? number_of_thread
+                                                        : matrix.GetCols();
+    level.placement = Topology::Get().Placement(level.threads);
+    result_.assign(matrix.GetRows(), 0);
 
     int rows = matrix.GetRows();
+    S21_TRACE_COUNTER("gauss threads spawned",
+                      (double)level.threads * (3 * rows - 1));
 
-    for (int i = 0; i < rows; ++i) {
-      DivideEquation(matrix, matrix(i, i), i);
-      SubtractElementsInMatrix(matrix, i);
+    {
+      S21_TRACE_SCOPE("gauss forward elimination");
+      for (int i = 0; i < rows; ++i) {
+        if (token.IsCancelled()) return {};
+        DivideEquation(level, matrix, matrix(i, i), i);
+        SubtractElementsInMatrix(level, matrix, i);
+      }
     }
 
+    S21_TRACE_SCOPE("gauss back substitution");
     result_[rows - 1] = matrix(rows - 1, rows);
-    EquateResultsToRightValues(matrix, result_);
+    EquateResultsToRightValues(level, matrix, result_);
 
     for (int i = rows - 2; i >= 0; --i) {
-      SubtractCalculatedVariables(matrix, result_, i);
+      SubtractCalculatedVariables(level, matrix, result_, i);
     }
   }
   return result_;
 }
 
-void GaussAlgorithm::DivideEquation(Matrix<double> &matrix, double matrix_elen,
+//  The structure is found once, not again in every candidate, and the
+//  solver it selects is part of the key so each kind is tuned on its own
+std::vector<double> GaussAlgorithm::GaussAutotuned(
+    Matrix<double> &matrix, const MatrixStructure &structure) {
+  if (!CheckGaussMatrix(matrix)) return std::vector<double>(matrix.GetRows());
+  MatrixStructure known = GetStructure_(matrix, structure);
+  std::vector<TunedConfig> candidates{{0, 1, 0, 0}};
+  for (int threads : Autotuner::ThreadCandidates())
+    candidates.push_back({1, threads, 0, 0});
+  TunedConfig best = Autotuner::Select(
+      Autotuner::MakeKey(std::string("gauss/") + SolverKind_(matrix, known),
+                         {matrix.GetRows()}),
+      candidates,
+      [&matrix, &known](const TunedConfig &config) {
+        Matrix<double> copy;
+        return Autotuner::Time(
+            [&]() {
+              if (config.variant == 0)
+                GaussWithoutParallelism(copy, known);
+              else
+                GaussWithParallelism(copy, known, config.threads);
+            },
+            [&]() { copy = matrix; });
+      });
+  return best.variant == 0
+             ? GaussWithoutParallelism(matrix, known)
+             : GaussWithParallelism(matrix, known, best.threads);
+}
+
+void GaussAlgorithm::DivideEquation(const ThreadLevel &level,
+                                    Matrix<double> &matrix, double matrix_elen,
                                     int i) {
-  std::vector<std::thread> threads(threads_in_level_);
-  for (int thread_id = 0; thread_id < threads_in_level_; ++thread_id) {
-    threads[thread_id] = std::thread(DivideEquationCycle, std::ref(matrix),
-                                     matrix_elen, i, thread_id);
+  std::vector<std::thread> threads(level.threads);
+  for (int thread_id = 0; thread_id < level.threads; ++thread_id) {
+    threads[thread_id] = Topology::StartThread(
+        level.placement[thread_id], DivideEquationCycle, std::ref(matrix),
+        matrix_elen, i, thread_id, level.threads);
   }
   JoinThreads(threads);
 }
 
 void GaussAlgorithm::DivideEquationCycle(Matrix<double> &matrix, double tmp,
-                                         int i, int thread_id) {
+                                         int i, int thread_id,
+                                         int threads_in_level) {
+  S21_TRACE_SCOPE("gauss divide row");
   std::pair<std::vector<int>, std::vector<int>> start_and_end_indices =
-      InitializeStartAndEndIndices(matrix.GetRows(), i - 1, false);
+      InitializeStartAndEndIndices(matrix.GetRows(), i - 1, false,
+                                   threads_in_level);
 
   for (int j = start_and_end_indices.first[thread_id];
        j > start_and_end_indices.second[thread_id]; --j) {
@@ -83,19 +191,24 @@ void GaussAlgorithm::DivideEquationCycle(Matrix<double> &matrix, double tmp,
   }
 }
 
-void GaussAlgorithm::SubtractElementsInMatrix(Matrix<double> &matrix, int i) {
-  std::vector<std::thread> threads(threads_in_level_);
-  for (int thread_id = 0; thread_id < threads_in_level_; ++thread_id) {
-    threads[thread_id] = std::thread(SubtractElementsInMatrixCycle,
-                                     std::ref(matrix), i, thread_id);
+void GaussAlgorithm::SubtractElementsInMatrix(const ThreadLevel &level,
+                                              Matrix<double> &matrix, int i) {
+  std::vector<std::thread> threads(level.threads);
+  for (int thread_id = 0; thread_id < level.threads; ++thread_id) {
+    threads[thread_id] = Topology::StartThread(
+        level.placement[thread_id], SubtractElementsInMatrixCycle,
+        std::ref(matrix), i, thread_id, level.threads);
   }
   JoinThreads(threads);
 }
 
 void GaussAlgorithm::SubtractElementsInMatrixCycle(Matrix<double> &matrix,
-                                                   int i, int thread_id) {
+                                                   int i, int thread_id,
+                                                   int threads_in_level) {
+  S21_TRACE_SCOPE("gauss subtract rows");
   std::pair<std::vector<int>, std::vector<int>> start_and_end_indices =
-      InitializeStartAndEndIndices(i + 1, matrix.GetRows(), true);
+      InitializeStartAndEndIndices(i + 1, matrix.GetRows(), true,
+                                   threads_in_level);
 
   for (int j = start_and_end_indices.first[thread_id];
        j < start_and_end_indices.second[thread_id]; ++j) {
@@ -106,50 +219,58 @@ void GaussAlgorithm::SubtractElementsInMatrixCycle(Matrix<double> &matrix,
   }
 }
 
-void GaussAlgorithm::EquateResultsToRightValues(Matrix<double> &matrix,
+void GaussAlgorithm::EquateResultsToRightValues(const ThreadLevel &level,
+                                                Matrix<double> &matrix,
                                                 std::vector<double> &result) {
-  std::vector<std::thread> threads(threads_in_level_);
-  for (int thread_id = 0; thread_id < threads_in_level_; ++thread_id) {
-    threads[thread_id] =
-        std::thread(EquateResultsToRightValuesCycle, std::ref(matrix),
-                    std::ref(result), thread_id);
+  std::vector<std::thread> threads(level.threads);
+  for (int thread_id = 0; thread_id < level.threads; ++thread_id) {
+    threads[thread_id] = Topology::StartThread(
+        level.placement[thread_id], EquateResultsToRightValuesCycle,
+        std::ref(matrix), std::ref(result), thread_id, level.threads);
   }
   JoinThreads(threads);
 }
 
 void GaussAlgorithm::EquateResultsToRightValuesCycle(
-    Matrix<double> &matrix, std::vector<double> &result, int thread_id) {
+    Matrix<double> &matrix, std::vector<double> &result, int thread_id,
+    int threads_in_level) {
+  S21_TRACE_SCOPE("gauss copy right values");
   std::pair<std::vector<int>, std::vector<int>> start_and_end_indices =
-      InitializeStartAndEndIndices(matrix.GetRows() - 2, -1, false);
+      InitializeStartAndEndIndices(matrix.GetRows() - 2, -1, false,
+                                   threads_in_level);
   for (int i = start_and_end_indices.first[thread_id];
        i > start_and_end_indices.second[thread_id]; --i) {
     result[i] = matrix(i, matrix.GetRows());
   }
 }
 
-void GaussAlgorithm::SubtractCalculatedVariables(Matrix<double> &matrix,
+void GaussAlgorithm::SubtractCalculatedVariables(const ThreadLevel &level,
+                                                 Matrix<double> &matrix,
                                                  std::vector<double> &result,
                                                  int i) {
-  std::vector<std::thread> threads(threads_in_level_);
+  std::vector<std::thread> threads(level.threads);
   std::mutex mtx;
-  for (int thread_id = 0; thread_id < threads_in_level_; ++thread_id) {
-    threads[thread_id] =
-        std::thread(SubtractCalculatedVariablesCycle, std::ref(matrix),
-                    std::ref(result), i, thread_id, std::ref(mtx));
+  for (int thread_id = 0; thread_id < level.threads; ++thread_id) {
+    threads[thread_id] = Topology::StartThread(
+        level.placement[thread_id], SubtractCalculatedVariablesCycle,
+        std::ref(matrix), std::ref(result), i, thread_id, level.threads,
+        std::ref(mtx));
   }
   JoinThreads(threads);
 }
 
 void GaussAlgorithm::SubtractCalculatedVariablesCycle(
     Matrix<double> &matrix, std::vector<double> &result, int i, int thread_id,
-    std::mutex &mtx) {
+    int threads_in_level, std::mutex &mtx) {
+  S21_TRACE_SCOPE("gauss subtract variables");
   std::pair<std::vector<int>, std::vector<int>> start_and_end_indices =
-      InitializeStartAndEndIndices(i + 1, matrix.GetRows(), true);
+      InitializeStartAndEndIndices(i + 1, matrix.GetRows(), true,
+                                   threads_in_level);
 
   for (int j = start_and_end_indices.first[thread_id];
        j < start_and_end_indices.second[thread_id]; ++j) {
     double calculated = matrix(i, j) * result[j];
-    mtx.lock();
+    S21_TRACE_LOCK(mtx, "gauss result lock");
     result[i] -= calculated;
     mtx.unlock();
   }
@@ -157,31 +278,108 @@ void GaussAlgorithm::SubtractCalculatedVariablesCycle(
 
 std::pair<std::vector<int>, std::vector<int>>
 GaussAlgorithm::InitializeStartAndEndIndices(int start_index, int end_index,
-                                             bool start_is_less_than_end) {
-  std::vector<int> start_indices(threads_in_level_);
-  std::vector<int> end_indices(threads_in_level_);
+                                             bool start_is_less_than_end,
+                                             int threads_in_level) {
+  std::vector<int> start_indices(threads_in_level);
+  std::vector<int> end_indices(threads_in_level);
   start_indices[0] = start_index;
-  end_indices[threads_in_level_ - 1] = end_index;
-  for (int i = 1; i < threads_in_level_; ++i) {
+  end_indices[threads_in_level - 1] = end_index;
+  for (int i = 1; i < threads_in_level; ++i) {
     if (start_is_less_than_end) {
       end_indices[i - 1] = start_indices[i] =
           start_indices[i - 1] +
-          (double)(end_index - start_index) / threads_in_level_;
+          (double)(end_index - start_index) / threads_in_level;
     } else {
       end_indices[i - 1] = start_indices[i] =
           start_indices[i - 1] -
-          (double)(start_index - end_index) / threads_in_level_;
+          (double)(start_index - end_index) / threads_in_level;
     }
   }
   return {start_indices, end_indices};
 }
 
 void GaussAlgorithm::JoinThreads(std::vector<std::thread> &threads) {
-  for (int i = 0; i < threads_in_level_; ++i) {
-    threads[i].join();
+  for (std::thread &thread : threads) thread.join();
+}
+
+MatrixStructure GaussAlgorithm::GetStructure_(
+    const Matrix<double> &matrix, const MatrixStructure &structure) {
+  if (structure.IsKnown() || matrix.GetRows() < kBandedMinRows)
+    return structure;
+  return MatrixStructure::Scan(matrix);
+}
+
+//  A zero pivot falls back to the general path, which reports it the same
+//  way as for any other size
+bool GaussAlgorithm::SolveIfSmall_(const Matrix<double> &matrix,
+                                   std::vector<double> &result) {
+  switch (matrix.GetRows()) {
+    case 2:
+      return SolveStatic_<2>(matrix, result);
+    case 3:
+      return SolveStatic_<3>(matrix, result);
+    case 4:
+      return SolveStatic_<4>(matrix, result);
+    default:
+      return false;
   }
 }
 
+template <int kSize>
+bool GaussAlgorithm::SolveStatic_(const Matrix<double> &matrix,
+                                  std::vector<double> &result) {
+  static_assert(kSize <= kStaticMaxRows, "raise kStaticMaxRows");
+  std::array<double, kSize> solution;
+  if (!StaticMatrix<double, kSize, kSize + 1>(matrix).Solve(solution))
+    return false;
+  result.assign(solution.begin(), solution.end());
+  return true;
+}
+
+bool GaussAlgorithm::SolveIfBanded_(Matrix<double> &matrix,
+                                    const MatrixStructure &structure,
+                                    std::vector<double> &result,
+                                    int number_of_thread) {
+  if (!IsBanded_(matrix, structure)) return false;
+  std::vector<double> banded_result = BandedGaussAlgorithm::SolveAugmented(
+      matrix, structure.lower_bandwidth, structure.upper_bandwidth,
+      number_of_thread);
+  if (banded_result.empty()) return false;
+  result = std::move(banded_result);
+  return true;
+}
+
+bool GaussAlgorithm::SolveIfSparse_(Matrix<double> &matrix,
+                                    const MatrixStructure &structure,
+                                    std::vector<double> &result) {
+  if (!IsSparse_(matrix, structure)) return false;
+  std::vector<double> sparse_result =
+      SparseGaussAlgorithm::SolveAugmented(matrix);
+  if (sparse_result.empty()) return false;
+  result = std::move(sparse_result);
+  return true;
+}
+
+const char *GaussAlgorithm::SolverKind_(const Matrix<double> &matrix,
+                                        const MatrixStructure &structure) {
+  if (IsBanded_(matrix, structure)) return "banded";
+  if (IsSparse_(matrix, structure)) return "sparse";
+  return "dense";
+}
+
+//  Band too wide for a quarter of the rows gains nothing over dense
+bool GaussAlgorithm::IsBanded_(const Matrix<double> &matrix,
+                               const MatrixStructure &structure) {
+  if (matrix.GetRows() < kBandedMinRows || !structure.IsKnown()) return false;
+  int lower = structure.lower_bandwidth, upper = structure.upper_bandwidth;
+  return (lower + upper + 1) * 4 <= matrix.GetRows();
+}
+
+bool GaussAlgorithm::IsSparse_(const Matrix<double> &matrix,
+                               const MatrixStructure &structure) {
+  return matrix.GetRows() >= kSparseMinRows && structure.IsSparse();
+}
+
 bool GaussAlgorithm::CheckGaussMatrix(const Matrix<double> &matrix) {
   return (matrix.GetRows() >= 2 && matrix.GetCols() == matrix.GetRows() + 1);
 }
@@ -6,7 +6,16 @@
 #include <thread>
 #include <vector>
 
+#include "../helpers/autotuner.h"
+#include "../helpers/cancellation.h"
 #include "../helpers/matrix.h"
+#include "../helpers/matrix_structure.h"
+#include "../helpers/matrix_view.h"
+#include "../helpers/static_matrix.h"
+#include "../helpers/topology.h"
+#include "../helpers/trace.h"
+#include "BandedGaussAlgorithm.h"
+#include "SparseGaussAlgorithm.h"
 
 using std::thread;
 using std::vector;
@@ -14,33 +23,121 @@ using std::vector;
 namespace s21 {
 class GaussAlgorithm {
  public:
-  static std::vector<double> GaussWithoutParallelism(Matrix<double> &matrix);
-  static std::vector<double> GaussWithParallelism(Matrix<double> &matrix);
+  //  token is polled before every pivot, a cancelled run returns an empty
+  //  vector. It is not polled inside BandedGaussAlgorithm and
+  //  SparseGaussAlgorithm: banded and sparse systems are handed over whole
+  //  and only observe it before they start.
+  static std::vector<double> GaussWithoutParallelism(
+      Matrix<double> &matrix,
+      const CancellationToken &token = CancellationToken());
+  static std::vector<double> GaussWithParallelism(
+      Matrix<double> &matrix, int number_of_thread = 0,
+      const CancellationToken &token = CancellationToken());
+  //  structure picks the banded or sparse solver, usually the one of
+  //  MatrixParser::GetStructure(). It must describe matrix as it is now;
+  //  an unknown structure costs one pass over the matrix, which the
+  //  overloads above always take.
+  static std::vector<double> GaussWithoutParallelism(
+      Matrix<double> &matrix, const MatrixStructure &structure,
+      const CancellationToken &token = CancellationToken());
+  static std::vector<double> GaussWithParallelism(
+      Matrix<double> &matrix, const MatrixStructure &structure,
+      int number_of_thread = 0,
+      const CancellationToken &token = CancellationToken());
+  //  Dense elimination in place on an n x (n + 1) window, e.g. one system
+  //  inside a larger buffer. No other solver is tried for it.
+  static std::vector<double> GaussWithoutParallelism(
+      MatrixView<double> system,
+      const CancellationToken &token = CancellationToken());
+  //  n x n coefficients in CSR form and the right-hand side, e.g. from
+  //  MatrixParser::LoadSystemFromFile. From kSparseMinRows on they go to
+  //  SparseGaussAlgorithm without a dense copy; smaller systems, and ones
+  //  it meets a zero pivot in, are expanded and eliminated densely.
+  static std::vector<double> GaussSparse(
+      const SparseMatrix<double> &matrix, const std::vector<double> &right,
+      const CancellationToken &token = CancellationToken());
+  //  Serial or parallel with the thread count the Autotuner found fastest
+  //  for this size class, the first call per class times every candidate
+  //  on copies of matrix
+  static std::vector<double> GaussAutotuned(
+      Matrix<double> &matrix,
+      const MatrixStructure &structure = MatrixStructure());
   static bool CheckGaussMatrix(const Matrix<double> &matrix);
+  //  Workers of GaussWithParallelism, they are pinned according to
+  //  Topology::GetPolicy()
+  static int GetNumberOfThreads(const Matrix<double> &matrix);
+
+  //  Serial solves of systems up to this size copy them into a
+  //  StaticMatrix and run its unrolled elimination, matrix is left as it is
+  static constexpr int kStaticMaxRows = 4;
+  //  Systems at least this large that MatrixStructure finds sparse are
+  //  passed to SparseGaussAlgorithm
+  static constexpr int kSparseMinRows = 64;
+  //  Systems at least this large whose band covers at most a quarter of
+  //  the row are passed to BandedGaussAlgorithm
+  static constexpr int kBandedMinRows = 16;
 
  private:
-  static int threads_in_level_;
+  //  State of one GaussWithParallelism call, kept on its stack so that
+  //  concurrent calls from a pool don't share it
+  struct ThreadLevel {
+    int threads = 1;
+    std::vector<int> placement;
+  };
+
+  //  Scanned only when structure is unknown and matrix is large enough
+  //  for the banded or sparse solvers to be considered at all
+  static MatrixStructure GetStructure_(const Matrix<double> &matrix,
+                                       const MatrixStructure &structure);
+  //  Systems of up to kStaticMaxRows unknowns, solved in a StaticMatrix
+  static bool SolveIfSmall_(const Matrix<double> &matrix,
+                            std::vector<double> &result);
+  template <int kSize>
+  static bool SolveStatic_(const Matrix<double> &matrix,
+                           std::vector<double> &result);
+  static bool SolveIfBanded_(Matrix<double> &matrix,
+                             const MatrixStructure &structure,
+                             std::vector<double> &result,
+                             int number_of_thread);
+  static bool SolveIfSparse_(Matrix<double> &matrix,
+                             const MatrixStructure &structure,
+                             std::vector<double> &result);
+  //  Which solver the dispatch above picks, "dense", "banded" or "sparse"
+  static const char *SolverKind_(const Matrix<double> &matrix,
+                                 const MatrixStructure &structure);
+  static bool IsBanded_(const Matrix<double> &matrix,
+                        const MatrixStructure &structure);
+  static bool IsSparse_(const Matrix<double> &matrix,
+                        const MatrixStructure &structure);
 
-  static void DivideEquation(Matrix<double> &matrix, double matrix_elen, int i);
+  static void DivideEquation(const ThreadLevel &level, Matrix<double> &matrix,
+                             double matrix_elen, int i);
   static void DivideEquationCycle(Matrix<double> &matrix, double tmp, int i,
-                                  int thread_id);
-  static void SubtractElementsInMatrix(Matrix<double> &matrix, int i);
+                                  int thread_id, int threads_in_level);
+  static void SubtractElementsInMatrix(const ThreadLevel &level,
+                                       Matrix<double> &matrix, int i);
   static void SubtractElementsInMatrixCycle(Matrix<double> &matrix, int i,
-                                            int thread_id);
-  static void EquateResultsToRightValues(Matrix<double> &matrix,
+                                            int thread_id,
+                                            int threads_in_level);
+  static void EquateResultsToRightValues(const ThreadLevel &level,
+                                         Matrix<double> &matrix,
                                          std::vector<double> &result);
   static void EquateResultsToRightValuesCycle(Matrix<double> &matrix,
                                               std::vector<double> &result,
-                                              int thread_id);
-  static void SubtractCalculatedVariables(Matrix<double> &matrix,
+                                              int thread_id,
+                                              int threads_in_level);
+  static void SubtractCalculatedVariables(const ThreadLevel &level,
+                                          Matrix<double> &matrix,
                                           std::vector<double> &result, int i);
   static void SubtractCalculatedVariablesCycle(Matrix<double> &matrix,
                                                std::vector<double> &result,
                                                int i, int thread_id,
+                                               int threads_in_level,
                                                std::mutex &mtx);
   static std::pair<std::vector<int>, std::vector<int>>
   InitializeStartAndEndIndices(int start_index, int end_index,
-                               bool start_is_less_than_end);
+                               bool start_is_less_than_end,
+                               int threads_in_level);
   static void JoinThreads(std::vector<std::thread> &threads);
 };
 }  // namespace s21
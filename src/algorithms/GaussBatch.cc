@@ -0,0 +1,144 @@
+#include "GaussBatch.h"
+
+#include <cmath>
+
+namespace s21 {
+GaussBatch::GaussBatch(int size) : size_(size) { error_ = size_ < 1; }
+
+void GaussBatch::Solve(const double *systems, long system_stride,
+                       double *result, long result_stride, int batch_count,
+                       int number_of_thread) {
+  failed_count_ = 0;
+  systems_per_second_ = 0;
+  if (error_ || batch_count < 1) return;
+  auto start_time = std::chrono::high_resolution_clock::now();
+  int groups = (batch_count + kLanes - 1) / kLanes;
+  if (number_of_thread > groups) number_of_thread = groups;
+  if (number_of_thread <= 1) {
+    ExecuteRange_(systems, system_stride, result, result_stride, 0,
+                  batch_count);
+  } else {
+    vector<int> placement = Topology::Get().Placement(number_of_thread);
+    vector<thread> threads(number_of_thread);
+    for (int i = 0; i < number_of_thread; i++) {
+      int start = i * groups / number_of_thread * kLanes;
+      int end = (i + 1) * groups / number_of_thread * kLanes;
+      if (end > batch_count) end = batch_count;
+      threads[i] = Topology::StartThread(
+          placement[i], &GaussBatch::ExecuteRange_, this, systems,
+          system_stride, result, result_stride, start, end);
+    }
+    for (int i = 0; i < number_of_thread; i++) threads[i].join();
+  }
+  std::chrono::duration<double> duration =
+      std::chrono::high_resolution_clock::now() - start_time;
+  if (duration.count() > 0)
+    systems_per_second_ = batch_count / duration.count();
+}
+
+void GaussBatch::ExecuteRange_(const double *systems, long system_stride,
+                               double *result, long result_stride, int start,
+                               int end) {
+  switch (size_) {
+    case 2:
+      ExecuteGroups_<2>(systems, system_stride, result, result_stride, start,
+                        end);
+      break;
+    case 3:
+      ExecuteGroups_<3>(systems, system_stride, result, result_stride, start,
+                        end);
+      break;
+    case 4:
+      ExecuteGroups_<4>(systems, system_stride, result, result_stride, start,
+                        end);
+      break;
+    case 8:
+      ExecuteGroups_<8>(systems, system_stride, result, result_stride, start,
+                        end);
+      break;
+    case 16:
+      ExecuteGroups_<16>(systems, system_stride, result, result_stride, start,
+                         end);
+      break;
+    case 32:
+      ExecuteGroups_<32>(systems, system_stride, result, result_stride, start,
+                         end);
+      break;
+    default:
+      ExecuteGroups_<0>(systems, system_stride, result, result_stride, start,
+                        end);
+  }
+}
+
+//  kSize == 0 selects the kernel with the size known only at run time
+template <int kSize>
+void GaussBatch::ExecuteGroups_(const double *systems, long system_stride,
+                                double *result, long result_stride, int start,
+                                int end) {
+  const int n = kSize ? kSize : size_;
+  const int cols = n + 1;
+  vector<double> packed((size_t)n * cols * kLanes), solution(n * kLanes);
+  int failed = 0;
+  for (int i = start; i < end; i += kLanes) {
+    int lanes = end - i < kLanes ? end - i : kLanes;
+    for (int l = 0; l < kLanes; l++) {
+      if (l < lanes) {
+        const double *source = systems + (i + l) * system_stride;
+        for (int e = 0; e < n * cols; e++) packed[e * kLanes + l] = source[e];
+      } else {
+        //  unused lanes hold the identity system to keep pivots non-zero
+        for (int e = 0; e < n * cols; e++)
+          packed[e * kLanes + l] = (e % cols == e / cols) ? 1 : 0;
+      }
+    }
+    EliminateGroup_<kSize>(packed, solution);
+    for (int l = 0; l < lanes; l++) {
+      double *destination = result + (i + l) * result_stride;
+      bool is_finite = true;
+      for (int r = 0; r < n; r++) {
+        destination[r] = solution[r * kLanes + l];
+        if (!std::isfinite(destination[r])) is_finite = false;
+      }
+      if (!is_finite) failed++;
+    }
+  }
+  failed_count_ += failed;
+}
+
+//  Same elimination as GaussAlgorithm::GaussWithoutParallelism, applied to
+//  kLanes systems at once
+template <int kSize>
+void GaussBatch::EliminateGroup_(vector<double> &packed,
+                                 vector<double> &solution) {
+  const int n = kSize ? kSize : size_;
+  const int cols = n + 1;
+  double *a = packed.data();
+  double *x = solution.data();
+  for (int i = 0; i < n; i++) {
+    double *pivot_row = a + i * cols * kLanes;
+    double inverse[kLanes];
+    for (int l = 0; l < kLanes; l++)
+      inverse[l] = 1.0 / pivot_row[i * kLanes + l];
+    for (int j = i; j < cols; j++)
+      for (int l = 0; l < kLanes; l++) pivot_row[j * kLanes + l] *= inverse[l];
+    for (int r = i + 1; r < n; r++) {
+      double *row = a + r * cols * kLanes;
+      double factor[kLanes];
+      for (int l = 0; l < kLanes; l++) factor[l] = row[i * kLanes + l];
+      for (int j = i; j < cols; j++)
+        for (int l = 0; l < kLanes; l++)
+          row[j * kLanes + l] -= factor[l] * pivot_row[j * kLanes + l];
+    }
+  }
+  for (int i = n - 1; i >= 0; i--) {
+    const double *row = a + i * cols * kLanes;
+    double sum[kLanes];
+    for (int l = 0; l < kLanes; l++) sum[l] = row[n * kLanes + l];
+    for (int j = i + 1; j < n; j++)
+      for (int l = 0; l < kLanes; l++)
+        sum[l] -= row[j * kLanes + l] * x[j * kLanes + l];
+    for (int l = 0; l < kLanes; l++) x[i * kLanes + l] = sum[l];
+  }
+}
+
+}  // namespace s21
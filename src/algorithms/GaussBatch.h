@@ -0,0 +1,53 @@
+#ifndef SRC_ALGORITHMS_GAUSSBATCH_H
+#define SRC_ALGORITHMS_GAUSSBATCH_H
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "../helpers/topology.h"
+
+using std::thread;
+using std::vector;
+
+namespace s21 {
+
+//  Solves many independent n x (n + 1) augmented systems of one size.
+//  System i starts at systems + i * system_stride (row-major, no padding),
+//  its n unknowns are written to result + i * result_stride.
+//  Whole systems are spread over the threads, inside a thread kLanes
+//  systems are packed side by side and eliminated together, one per SIMD
+//  lane. Sizes 2, 3, 4, 8, 16 and 32 get kernels with a compile-time size.
+class GaussBatch {
+ public:
+  explicit GaussBatch(int size);
+  ~GaussBatch() = default;
+
+  void Solve(const double *systems, long system_stride, double *result,
+             long result_stride, int batch_count, int number_of_thread = 1);
+  bool GetError() { return error_; }
+  //  Systems whose solution came out non-finite, e.g. after a zero pivot
+  int GetFailedCount() { return failed_count_; }
+  double GetSystemsPerSecond() { return systems_per_second_; }
+
+ private:
+  static constexpr int kLanes = 4;
+
+  int size_;
+  bool error_ = false;
+  std::atomic<int> failed_count_{0};
+  double systems_per_second_ = 0;
+
+  void ExecuteRange_(const double *systems, long system_stride,
+                     double *result, long result_stride, int start, int end);
+  template <int kSize>
+  void ExecuteGroups_(const double *systems, long system_stride,
+                      double *result, long result_stride, int start, int end);
+  template <int kSize>
+  void EliminateGroup_(vector<double> &packed, vector<double> &solution);
+};
+
+}  // namespace s21
+
+#endif  //  SRC_ALGORITHMS_GAUSSBATCH_H
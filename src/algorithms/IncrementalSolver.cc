@@ -0,0 +1,154 @@
+#include "IncrementalSolver.h"
+
+#include <cmath>
+#include <limits>
+
+#include "GaussAlgorithm.h"
+
+namespace s21 {
+//  Takes the same n x (n + 1) augmented matrix as GaussAlgorithm and keeps
+//  its own copy, the input is not modified
+IncrementalSolver::IncrementalSolver(Matrix<double> &matrix, int max_rank,
+                                     double tolerance)
+    : max_rank_(max_rank), tolerance_(tolerance) {
+  error_ = !GaussAlgorithm::CheckGaussMatrix(matrix);
+  if (!error_) {
+    size_ = matrix.GetRows();
+    matrix_ = Matrix<double>(size_, size_);
+    right_.resize(size_);
+    ConstMatrixView<double> system(matrix);
+    system.Block(0, 0, size_, size_).CopyTo(matrix_);
+    for (int i = 0; i < size_; ++i) right_[i] = system(i, size_);
+    Refactor();
+    refactor_count_ = 0;
+  }
+}
+
+void IncrementalSolver::Refactor() {
+  update_v_.clear();
+  update_z_.clear();
+  capacitance_.clear();
+  error_ = !lu_.Factorize(matrix_);
+  refactor_count_++;
+}
+
+std::vector<double> IncrementalSolver::Solve() {
+  std::vector<double> solution;
+  if (size_ == 0) return solution;
+  if (error_) return solution;
+  solution = right_;
+  lu_.Solve(solution);
+  if (GetRank() > 0 && (!ApplyUpdates_(solution) ||
+                        !(BackwardError_(solution) <= tolerance_))) {
+    Refactor();
+    if (error_) return {};
+    solution = right_;
+    lu_.Solve(solution);
+  }
+  return solution;
+}
+
+//  x = y - Z * C^-1 * V^T * y for y = A0^-1 * b
+bool IncrementalSolver::ApplyUpdates_(std::vector<double> &solution) {
+  int rank = GetRank();
+  Matrix<double> capacitance(rank, rank);
+  std::vector<double> weights(rank);
+  for (int i = 0; i < rank; ++i) {
+    for (int j = 0; j < rank; ++j) capacitance(i, j) = capacitance_[i][j];
+    weights[i] = Dot_(update_v_[i], solution);
+  }
+  LuDecomposition<double> lu(capacitance);
+  if (lu.GetError()) return false;
+  lu.Solve(weights);
+  for (int k = 0; k < rank; ++k)
+    for (int i = 0; i < size_; ++i)
+      solution[i] -= update_z_[k][i] * weights[k];
+  return true;
+}
+
+void IncrementalSolver::UpdateRankOne(const std::vector<double> &u,
+                                      const std::vector<double> &v) {
+  if (size_ == 0 || (int)u.size() != size_ || (int)v.size() != size_) return;
+  for (int i = 0; i < size_; ++i) {
+    if (u[i] == 0) continue;
+    double *row = matrix_.GetRow(i);
+    for (int j = 0; j < size_; ++j) row[j] += u[i] * v[j];
+  }
+  if (error_ || GetRank() >= max_rank_) {
+    Refactor();
+    return;
+  }
+  std::vector<double> z = u;
+  lu_.Solve(z);
+  int rank = GetRank();
+  for (int i = 0; i < rank; ++i)
+    capacitance_[i].push_back(Dot_(update_v_[i], z));
+  update_v_.push_back(v);
+  update_z_.push_back(std::move(z));
+  capacitance_.emplace_back(rank + 1);
+  for (int j = 0; j <= rank; ++j)
+    capacitance_[rank][j] = Dot_(update_v_[rank], update_z_[j]);
+  capacitance_[rank][rank] += 1;
+}
+
+void IncrementalSolver::UpdateEntry(int row, int col, double value) {
+  double delta = value - matrix_(row, col);
+  if (delta == 0) return;
+  std::vector<double> u(size_, 0), v(size_, 0);
+  u[row] = delta;
+  v[col] = 1;
+  UpdateRankOne(u, v);
+}
+
+void IncrementalSolver::UpdateRow(int row, const std::vector<double> &values) {
+  if ((int)values.size() != size_) return;
+  std::vector<double> u(size_, 0), v(values);
+  const double *old_row = matrix_.GetRow(row);
+  for (int j = 0; j < size_; ++j) v[j] -= old_row[j];
+  u[row] = 1;
+  UpdateRankOne(u, v);
+}
+
+void IncrementalSolver::UpdateColumn(int col,
+                                     const std::vector<double> &values) {
+  if ((int)values.size() != size_) return;
+  std::vector<double> u(values), v(size_, 0);
+  for (int i = 0; i < size_; ++i) u[i] -= matrix_(i, col);
+  v[col] = 1;
+  UpdateRankOne(u, v);
+}
+
+void IncrementalSolver::SetRightValue(int row, double value) {
+  if (row < 0 || row >= size_) throw std::range_error("Incorrect matrix size_");
+  right_[row] = value;
+}
+
+//  ||b - Ax|| / (||A|| ||x|| + ||b||) in the infinity norm
+double IncrementalSolver::BackwardError_(const std::vector<double> &solution) {
+  double norm_remainder = 0, norm_matrix = 0, norm_solution = 0,
+         norm_right = 0;
+  for (int i = 0; i < size_; ++i) {
+    const double *row = matrix_.GetRow(i);
+    double sum = right_[i], row_norm = 0;
+    for (int j = 0; j < size_; ++j) {
+      sum -= row[j] * solution[j];
+      row_norm += std::fabs(row[j]);
+    }
+    if (!std::isfinite(sum)) return std::numeric_limits<double>::infinity();
+    norm_remainder = std::fmax(norm_remainder, std::fabs(sum));
+    norm_matrix = std::fmax(norm_matrix, row_norm);
+    norm_solution = std::fmax(norm_solution, std::fabs(solution[i]));
+    norm_right = std::fmax(norm_right, std::fabs(right_[i]));
+  }
+  double scale = norm_matrix * norm_solution + norm_right;
+  return scale > 0 ? norm_remainder / scale : 0;
+}
+
+double IncrementalSolver::Dot_(const std::vector<double> &first,
+                               const std::vector<double> &second) {
+  double sum = 0;
+  for (size_t i = 0; i < first.size(); ++i) sum += first[i] * second[i];
+  return sum;
+}
+
+}  // namespace s21
@@ -0,0 +1,57 @@
+#ifndef SRC_ALGORITHMS_INCREMENTALSOLVER_H
+#define SRC_ALGORITHMS_INCREMENTALSOLVER_H
+
+#include <vector>
+
+#include "../helpers/matrix.h"
+#include "LuDecomposition.h"
+
+namespace s21 {
+//  Keeps the LU factorization of an augmented system between solves.
+//  Changes to the coefficients are collected as rank-1 terms A += u * v^T
+//  and applied with the Sherman-Morrison-Woodbury formula, which costs
+//  O(n^2) per update and per solve instead of a new O(n^3) elimination.
+//  The system is factored again once max_rank updates have piled up or
+//  the backward error of a solution exceeds the tolerance.
+class IncrementalSolver {
+ public:
+  explicit IncrementalSolver(Matrix<double> &matrix, int max_rank = 16,
+                             double tolerance = 1e-10);
+  ~IncrementalSolver() = default;
+
+  std::vector<double> Solve();
+  void UpdateEntry(int row, int col, double value);
+  void UpdateRow(int row, const std::vector<double> &values);
+  void UpdateColumn(int col, const std::vector<double> &values);
+  void UpdateRankOne(const std::vector<double> &u,
+                     const std::vector<double> &v);
+  void SetRightValue(int row, double value);
+  void Refactor();
+
+  bool GetError() { return error_; }
+  [[nodiscard]] int GetRank() const { return (int)update_v_.size(); }
+  [[nodiscard]] int GetRefactorCount() const { return refactor_count_; }
+
+ private:
+  int size_{};
+  int max_rank_;
+  double tolerance_;
+  bool error_{false};
+  int refactor_count_{};
+
+  Matrix<double> matrix_;
+  std::vector<double> right_;
+  LuDecomposition<double> lu_;
+  //  v_i and z_i = A0^-1 * u_i of every pending update, with the
+  //  capacitance matrix C = I + V^T * Z built up alongside
+  std::vector<std::vector<double>> update_v_, update_z_;
+  std::vector<std::vector<double>> capacitance_;
+
+  bool ApplyUpdates_(std::vector<double> &solution);
+  double BackwardError_(const std::vector<double> &solution);
+  static double Dot_(const std::vector<double> &first,
+                     const std::vector<double> &second);
+};
+}  // namespace s21
+
+#endif  // SRC_ALGORITHMS_INCREMENTALSOLVER_H
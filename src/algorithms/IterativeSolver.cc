@@ -0,0 +1,266 @@
+#include "IterativeSolver.h"
+
+#include <cmath>
+
+#include "GaussAlgorithm.h"
+
+namespace s21 {
+//  Takes the same n x (n + 1) augmented matrix as GaussAlgorithm, sparse
+//  systems are kept in CSR form
+IterativeSolver::IterativeSolver(Matrix<double> &matrix) {
+  error_ = !GaussAlgorithm::CheckGaussMatrix(matrix);
+  if (!error_) {
+    size_ = matrix.GetRows();
+    right_.resize(size_);
+    for (int i = 0; i < size_; ++i) right_[i] = matrix(i, size_);
+    is_sparse_ = MatrixStructure::Scan(matrix).IsSparse();
+    if (is_sparse_) {
+      sparse_ = SparseMatrix<double>(matrix, size_);
+    } else {
+      dense_.resize((size_t)size_ * size_);
+      for (int i = 0; i < size_; ++i)
+        for (int j = 0; j < size_; ++j)
+          dense_[(size_t)i * size_ + j] = matrix(i, j);
+    }
+    ExtractDiagonal_();
+  }
+}
+
+IterativeSolver::IterativeSolver(const SparseMatrix<double> &matrix,
+                                 const std::vector<double> &right)
+    : size_(matrix.GetRows()),
+      is_sparse_(true),
+      sparse_(matrix),
+      right_(right) {
+  error_ = size_ < 1 || matrix.GetCols() != size_ || (int)right.size() != size_;
+  if (!error_) ExtractDiagonal_();
+}
+
+void IterativeSolver::ExtractDiagonal_() {
+  diagonal_.assign(size_, 0);
+  for (int i = 0; i < size_; ++i) {
+    diagonal_[i] = is_sparse_ ? sparse_(i, i) : dense_[(size_t)i * size_ + i];
+    if (diagonal_[i] == 0) error_ = true;
+  }
+}
+
+IterativeResult IterativeSolver::Solve(const IterativeOptions &options) {
+  result_ = IterativeResult();
+  if (error_) return result_;
+  options_ = options;
+  int number_of_thread = options_.number_of_thread;
+  if (number_of_thread > size_) number_of_thread = size_;
+  if (number_of_thread < 1) number_of_thread = 1;
+
+  right_norm_ = 0;
+  for (double value : right_) right_norm_ += value * value;
+  right_norm_ = std::sqrt(right_norm_);
+  if (right_norm_ == 0) right_norm_ = 1;
+
+  solution_[0].assign(size_, 0);
+  solution_[1].assign(size_, 0);
+  if (options_.method == IterativeMethod::CONJUGATE_GRADIENT) {
+    direction_.assign(size_, 0);
+    product_.assign(size_, 0);
+    remainder_.assign(size_, 0);
+    preconditioned_.assign(size_, 0);
+  }
+  for (auto &partial : partial_) partial.assign(number_of_thread, 0);
+  partial_extra_.assign(number_of_thread, 0);
+  time_over_[0] = time_over_[1] = false;
+  start_time_ = Clock::now();
+
+  Barrier barrier(number_of_thread);
+  auto execution = &IterativeSolver::ConjugateGradientExecution_;
+  if (options_.method == IterativeMethod::JACOBI)
+    execution = &IterativeSolver::JacobiExecution_;
+  else if (options_.method == IterativeMethod::GAUSS_SEIDEL)
+    execution = &IterativeSolver::GaussSeidelExecution_;
+
+  std::vector<int> placement = Topology::Get().Placement(number_of_thread);
+  std::vector<std::thread> threads(number_of_thread - 1);
+  for (int i = 1; i < number_of_thread; ++i) {
+    threads[i - 1] = Topology::StartThread(
+        placement[i], execution, this, i, i * size_ / number_of_thread,
+        (i + 1) * size_ / number_of_thread, std::ref(barrier));
+  }
+  (this->*execution)(0, 0, size_ / number_of_thread, barrier);
+  for (auto &th : threads) th.join();
+
+  int last = options_.method == IterativeMethod::JACOBI
+                 ? result_.iterations & 1
+                 : 0;
+  result_.solution = std::move(solution_[last]);
+  return result_;
+}
+
+void IterativeSolver::JacobiExecution_(int thread_id, int start, int end,
+                                       Barrier &barrier) {
+  for (int iteration = 0;; ++iteration) {
+    const std::vector<double> &current = solution_[iteration & 1];
+    std::vector<double> &next = solution_[(iteration + 1) & 1];
+    double sum = 0;
+    for (int i = start; i < end; ++i) {
+      double remainder = right_[i] - RowProduct_(i, current);
+      next[i] = current[i] + remainder / diagonal_[i];
+      sum += remainder * remainder;
+    }
+    partial_[iteration & 1][thread_id] = sum;
+    CheckTime_(thread_id, iteration);
+    barrier.Wait();
+    if (IsFinished_(thread_id, iteration, Reduce_(partial_[iteration & 1])))
+      break;
+  }
+}
+
+//  Red-black ordering: even rows are relaxed from the previous solution,
+//  then odd rows from the updated even ones. The two colours are written
+//  to alternate buffers so that threads never read a value being updated.
+void IterativeSolver::GaussSeidelExecution_(int thread_id, int start, int end,
+                                            Barrier &barrier) {
+  std::vector<double> &current = solution_[0];
+  std::vector<double> &half_step = solution_[1];
+  double relaxation = options_.relaxation;
+  for (int iteration = 0;; ++iteration) {
+    double sum = 0;
+    for (int i = start; i < end; ++i) {
+      double remainder = right_[i] - RowProduct_(i, current);
+      sum += remainder * remainder;
+      half_step[i] = current[i];
+      if (i % 2 == 0) half_step[i] += relaxation * remainder / diagonal_[i];
+    }
+    partial_[0][thread_id] = sum;
+    CheckTime_(thread_id, iteration);
+    barrier.Wait();
+    if (IsFinished_(thread_id, iteration, Reduce_(partial_[0]))) break;
+
+    for (int i = start; i < end; ++i) {
+      current[i] = half_step[i];
+      if (i % 2 == 1)
+        current[i] += relaxation * (right_[i] - RowProduct_(i, half_step)) /
+                      diagonal_[i];
+    }
+    barrier.Wait();
+  }
+}
+
+void IterativeSolver::ConjugateGradientExecution_(int thread_id, int start,
+                                                  int end, Barrier &barrier) {
+  std::vector<double> &solution = solution_[0];
+  double sum_rz = 0, sum_rr = 0;
+  for (int i = start; i < end; ++i) {
+    remainder_[i] = right_[i];
+    preconditioned_[i] = remainder_[i] / diagonal_[i];
+    direction_[i] = preconditioned_[i];
+    sum_rz += remainder_[i] * preconditioned_[i];
+    sum_rr += remainder_[i] * remainder_[i];
+  }
+  partial_[0][thread_id] = sum_rz;
+  partial_[1][thread_id] = sum_rr;
+  CheckTime_(thread_id, 0);
+  barrier.Wait();
+  double rz = Reduce_(partial_[0]), rr = Reduce_(partial_[1]);
+
+  for (int iteration = 0; !IsFinished_(thread_id, iteration, rr);
+       ++iteration) {
+    MulRows_(direction_, product_, start, end);
+    double sum_pq = 0;
+    for (int i = start; i < end; ++i) sum_pq += direction_[i] * product_[i];
+    partial_extra_[thread_id] = sum_pq;
+    barrier.Wait();
+
+    double alpha = rz / Reduce_(partial_extra_);
+    sum_rz = sum_rr = 0;
+    for (int i = start; i < end; ++i) {
+      solution[i] += alpha * direction_[i];
+      remainder_[i] -= alpha * product_[i];
+      preconditioned_[i] = remainder_[i] / diagonal_[i];
+      sum_rz += remainder_[i] * preconditioned_[i];
+      sum_rr += remainder_[i] * remainder_[i];
+    }
+    partial_[0][thread_id] = sum_rz;
+    partial_[1][thread_id] = sum_rr;
+    CheckTime_(thread_id, iteration + 1);
+    barrier.Wait();
+
+    double next_rz = Reduce_(partial_[0]);
+    rr = Reduce_(partial_[1]);
+    double beta = next_rz / rz;
+    rz = next_rz;
+    for (int i = start; i < end; ++i)
+      direction_[i] = preconditioned_[i] + beta * direction_[i];
+    barrier.Wait();
+  }
+}
+
+//  Only the first thread looks at the clock, the others pick its decision
+//  up after the next barrier
+void IterativeSolver::CheckTime_(int thread_id, int iteration) {
+  if (thread_id == 0 && options_.time_limit > 0) {
+    std::chrono::duration<double> duration = Clock::now() - start_time_;
+    time_over_[iteration & 1] = duration.count() > options_.time_limit;
+  }
+}
+
+bool IterativeSolver::IsFinished_(int thread_id, int iteration,
+                                  double residual_square) {
+  double residual = std::sqrt(residual_square) / right_norm_;
+  bool converged = residual <= options_.tolerance;
+  bool finished = converged || iteration >= options_.max_iterations ||
+                  time_over_[iteration & 1] || std::isnan(residual);
+  if (finished && thread_id == 0) {
+    result_.iterations = iteration;
+    result_.residual = residual;
+    result_.converged = converged;
+  }
+  return finished;
+}
+
+double IterativeSolver::Reduce_(const std::vector<double> &partial) {
+  double sum = 0;
+  for (double value : partial) sum += value;
+  return sum;
+}
+
+double IterativeSolver::RowProduct_(int row,
+                                    const std::vector<double> &vector) {
+  double sum = 0;
+  if (is_sparse_) {
+    const std::vector<int> &row_start = sparse_.GetRowStart();
+    const std::vector<int> &col_index = sparse_.GetColIndex();
+    const std::vector<double> &values = sparse_.GetValues();
+    for (int k = row_start[row]; k < row_start[row + 1]; ++k)
+      sum += values[k] * vector[col_index[k]];
+  } else {
+    const double *line = &dense_[(size_t)row * size_];
+    for (int j = 0; j < size_; ++j) sum += line[j] * vector[j];
+  }
+  return sum;
+}
+
+void IterativeSolver::MulRows_(const std::vector<double> &vector,
+                               std::vector<double> &result, int start,
+                               int end) {
+  for (int i = start; i < end; ++i) result[i] = RowProduct_(i, vector);
+}
+
+void IterativeSolver::MulVector(const std::vector<double> &vector,
+                                std::vector<double> &result,
+                                int number_of_thread) {
+  if (error_ || (int)vector.size() != size_) return;
+  result.assign(size_, 0);
+  if (number_of_thread > size_) number_of_thread = size_;
+  std::vector<int> placement = Topology::Get().Placement(number_of_thread);
+  std::vector<std::thread> threads;
+  for (int i = 1; i < number_of_thread; ++i) {
+    threads.push_back(Topology::StartThread(
+        placement[i], &IterativeSolver::MulRows_, this, std::cref(vector),
+        std::ref(result), i * size_ / number_of_thread,
+        (i + 1) * size_ / number_of_thread));
+  }
+  MulRows_(vector, result, 0,
+           number_of_thread > 1 ? size_ / number_of_thread : size_);
+  for (auto &th : threads) th.join();
+}
+
+}  // namespace s21
@@ -0,0 +1,89 @@
+#ifndef SRC_ALGORITHMS_ITERATIVESOLVER_H
+#define SRC_ALGORITHMS_ITERATIVESOLVER_H
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "../helpers/barrier.h"
+#include "../helpers/matrix.h"
+#include "../helpers/sparse_matrix.h"
+#include "../helpers/topology.h"
+
+namespace s21 {
+
+enum IterativeMethod { JACOBI, GAUSS_SEIDEL, CONJUGATE_GRADIENT };
+
+struct IterativeOptions {
+  IterativeMethod method = IterativeMethod::CONJUGATE_GRADIENT;
+  double tolerance = 1e-10;  //  on ||b - Ax|| / ||b||
+  int max_iterations = 10000;
+  double time_limit = 0;   //  seconds, 0 means no limit
+  double relaxation = 1.0;  //  SOR factor, 1 is plain Gauss-Seidel
+  int number_of_thread = 1;
+};
+
+struct IterativeResult {
+  std::vector<double> solution;
+  int iterations = 0;
+  double residual = 0;
+  bool converged = false;
+};
+
+//  Jacobi, red-black Gauss-Seidel/SOR and Jacobi-preconditioned conjugate
+//  gradients for large diagonally dominant or symmetric positive definite
+//  systems. Every solve runs as one team of threads that own contiguous
+//  row ranges and meet at barriers for the reductions.
+class IterativeSolver {
+ public:
+  explicit IterativeSolver(Matrix<double> &matrix);
+  IterativeSolver(const SparseMatrix<double> &matrix,
+                  const std::vector<double> &right);
+  ~IterativeSolver() = default;
+
+  IterativeResult Solve(const IterativeOptions &options);
+  void MulVector(const std::vector<double> &vector, std::vector<double> &result,
+                 int number_of_thread = 1);
+  bool GetError() { return error_; }
+  bool IsSparse() { return is_sparse_; }
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  int size_{};
+  bool error_{false};
+  bool is_sparse_{false};
+  std::vector<double> dense_;
+  SparseMatrix<double> sparse_;
+  std::vector<double> diagonal_;
+  std::vector<double> right_;
+
+  IterativeOptions options_;
+  IterativeResult result_;
+  Clock::time_point start_time_;
+  double right_norm_{};
+  //  Jacobi and Gauss-Seidel alternate between the two solution buffers,
+  //  conjugate gradients keep the solution in the first one
+  std::vector<double> solution_[2];
+  std::vector<double> direction_, product_, remainder_, preconditioned_;
+  //  Per-thread partial sums, indexed by iteration parity where a thread
+  //  may already write the next ones while others still read
+  std::vector<double> partial_[2], partial_extra_;
+  bool time_over_[2]{};
+
+  void ExtractDiagonal_();
+  double RowProduct_(int row, const std::vector<double> &vector);
+  void MulRows_(const std::vector<double> &vector, std::vector<double> &result,
+                int start, int end);
+  void JacobiExecution_(int thread_id, int start, int end, Barrier &barrier);
+  void GaussSeidelExecution_(int thread_id, int start, int end,
+                             Barrier &barrier);
+  void ConjugateGradientExecution_(int thread_id, int start, int end,
+                                   Barrier &barrier);
+  double Reduce_(const std::vector<double> &partial);
+  void CheckTime_(int thread_id, int iteration);
+  bool IsFinished_(int thread_id, int iteration, double residual_square);
+};
+}  // namespace s21
+
+#endif  // SRC_ALGORITHMS_ITERATIVESOLVER_H
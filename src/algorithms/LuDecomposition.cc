@@ -0,0 +1,78 @@
+#include "LuDecomposition.h"
+
+#include <cmath>
+#include <utility>
+
+namespace s21 {
+template <class T>
+LuDecomposition<T>::LuDecomposition(const Matrix<T> &matrix) {
+  Factorize(matrix);
+}
+
+template <class T>
+LuDecomposition<T>::LuDecomposition(ConstMatrixView<T> matrix) {
+  Factorize(matrix);
+}
+
+template <class T>
+bool LuDecomposition<T>::Factorize(const Matrix<T> &matrix) {
+  return Factorize(ConstMatrixView<T>(matrix));
+}
+
+//  Returns false for non-square or singular matrices, lu_ keeps its
+//  storage when the size doesn't change
+template <class T>
+bool LuDecomposition<T>::Factorize(ConstMatrixView<T> matrix) {
+  if (lu_.GetRows() != matrix.GetRows() || lu_.GetCols() != matrix.GetCols())
+    lu_ = Matrix<T>(matrix.GetRows(), matrix.GetCols());
+  matrix.CopyTo(lu_);
+  int size = lu_.GetRows();
+  error_ = size < 1 || lu_.GetCols() != size;
+  pivots_.resize(error_ ? 0 : size);
+  for (int k = 0; k < size && !error_; ++k) {
+    int pivot = k;
+    for (int i = k + 1; i < size; ++i)
+      if (std::fabs(lu_(i, k)) > std::fabs(lu_(pivot, k))) pivot = i;
+    pivots_[k] = pivot;
+    if (lu_(pivot, k) == 0) {
+      error_ = true;
+      break;
+    }
+    if (pivot != k) {
+      T *first = lu_.GetRow(k), *second = lu_.GetRow(pivot);
+      for (int j = 0; j < size; ++j) std::swap(first[j], second[j]);
+    }
+    const T *pivot_row = lu_.GetRow(k);
+    for (int i = k + 1; i < size; ++i) {
+      T *row = lu_.GetRow(i);
+      T factor = row[k] / pivot_row[k];
+      row[k] = factor;
+      for (int j = k + 1; j < size; ++j) row[j] -= factor * pivot_row[j];
+    }
+  }
+  return !error_;
+}
+
+template <class T>
+void LuDecomposition<T>::Solve(std::vector<T> &vector) {
+  int size = lu_.GetRows();
+  if (error_ || (int)vector.size() != size) return;
+  for (int k = 0; k < size; ++k) std::swap(vector[k], vector[pivots_[k]]);
+  for (int i = 0; i < size; ++i) {
+    const T *row = lu_.GetRow(i);
+    T sum = vector[i];
+    for (int j = 0; j < i; ++j) sum -= row[j] * vector[j];
+    vector[i] = sum;
+  }
+  for (int i = size - 1; i >= 0; --i) {
+    const T *row = lu_.GetRow(i);
+    T sum = vector[i];
+    for (int j = i + 1; j < size; ++j) sum -= row[j] * vector[j];
+    vector[i] = sum / row[i];
+  }
+}
+
+}  // namespace s21
+
+template class s21::LuDecomposition<double>;
+template class s21::LuDecomposition<float>;
@@ -0,0 +1,36 @@
+#ifndef SRC_ALGORITHMS_LUDECOMPOSITION_H
+#define SRC_ALGORITHMS_LUDECOMPOSITION_H
+
+#include <vector>
+
+#include "../helpers/matrix.h"
+#include "../helpers/matrix_view.h"
+
+namespace s21 {
+//  PA = LU with partial pivoting, kept so that one factorization can be
+//  reused for any number of right-hand sides. L has a unit diagonal and
+//  shares the storage with U.
+template <class T>
+class LuDecomposition {
+ public:
+  LuDecomposition() = default;
+  explicit LuDecomposition(const Matrix<T> &matrix);
+  explicit LuDecomposition(ConstMatrixView<T> matrix);
+  ~LuDecomposition() = default;
+
+  bool Factorize(const Matrix<T> &matrix);
+  //  Factorizes a square window, e.g. the coefficients of an augmented
+  //  system, without copying it out first
+  bool Factorize(ConstMatrixView<T> matrix);
+  void Solve(std::vector<T> &vector);
+  bool GetError() { return error_; }
+  [[nodiscard]] int GetSize() const { return lu_.GetRows(); }
+
+ private:
+  Matrix<T> lu_;
+  std::vector<int> pivots_;
+  bool error_{true};
+};
+}  // namespace s21
+
+#endif  // SRC_ALGORITHMS_LUDECOMPOSITION_H
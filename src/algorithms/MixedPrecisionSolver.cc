@@ -0,0 +1,109 @@
+#include "MixedPrecisionSolver.h"
+
+#include <cmath>
+
+#include "GaussAlgorithm.h"
+
+namespace s21 {
+MixedPrecisionSolver::MixedPrecisionSolver(int max_steps, double tolerance)
+    : max_steps_(max_steps), tolerance_(tolerance) {}
+
+//  The input augmented matrix is left untouched, unlike in GaussAlgorithm
+MixedPrecisionResult MixedPrecisionSolver::Solve(Matrix<double> &matrix,
+                                                 bool measure_speedup) {
+  MixedPrecisionResult result;
+  error_ = !GaussAlgorithm::CheckGaussMatrix(matrix);
+  if (error_) return result;
+  int size = matrix.GetRows();
+  double threshold = tolerance_ * std::sqrt((double)size);
+
+  auto start_time = Clock::now();
+  LuDecomposition<float> lu(Coefficients_<float>(matrix));
+  bool is_factorized = !lu.GetError();
+  std::vector<double> solution(size, 0), remainder;
+  std::vector<float> correction(size);
+  double residual = Residual_(matrix, solution, remainder);
+  double previous = residual;
+  bool is_converged = residual <= threshold;
+  for (int step = 0; is_factorized && !is_converged && step < max_steps_;
+       ++step) {
+    for (int i = 0; i < size; ++i) correction[i] = (float)remainder[i];
+    lu.Solve(correction);
+    for (int i = 0; i < size; ++i) solution[i] += correction[i];
+    result.refinement_steps++;
+    residual = Residual_(matrix, solution, remainder);
+    is_converged = residual <= threshold;
+    if (!is_converged && step > 0 && residual > 0.5 * previous) break;
+    previous = residual;
+  }
+  if (!is_converged) {
+    result.fell_back = true;
+    error_ = !SolveInDouble_(matrix, solution);
+    residual = Residual_(matrix, solution, remainder);
+  }
+  std::chrono::duration<double> duration = Clock::now() - start_time;
+  result.time = duration.count();
+  result.residual = residual;
+  result.solution = std::move(solution);
+
+  if (measure_speedup) {
+    std::vector<double> reference;
+    start_time = Clock::now();
+    SolveInDouble_(matrix, reference);
+    duration = Clock::now() - start_time;
+    result.double_time = duration.count();
+    if (result.time > 0) result.speedup = result.double_time / result.time;
+  }
+  return result;
+}
+
+bool MixedPrecisionSolver::SolveInDouble_(Matrix<double> &matrix,
+                                          std::vector<double> &solution) {
+  int size = matrix.GetRows();
+  LuDecomposition<double> lu(Coefficients_<double>(matrix));
+  if (lu.GetError()) return false;
+  solution.resize(size);
+  for (int i = 0; i < size; ++i) solution[i] = matrix(i, size);
+  lu.Solve(solution);
+  return true;
+}
+
+//  remainder = b - Ax in double, returns the normwise backward error
+//  ||b - Ax|| / (||A|| ||x|| + ||b||) in the infinity norm
+double MixedPrecisionSolver::Residual_(Matrix<double> &matrix,
+                                       const std::vector<double> &solution,
+                                       std::vector<double> &remainder) {
+  int size = matrix.GetRows();
+  remainder.resize(size);
+  double norm_remainder = 0, norm_matrix = 0, norm_solution = 0,
+         norm_right = 0;
+  for (int i = 0; i < size; ++i) {
+    const double *row = matrix.GetRow(i);
+    double sum = row[size], row_norm = 0;
+    for (int j = 0; j < size; ++j) {
+      sum -= row[j] * solution[j];
+      row_norm += std::fabs(row[j]);
+    }
+    remainder[i] = sum;
+    norm_remainder = std::fmax(norm_remainder, std::fabs(sum));
+    norm_matrix = std::fmax(norm_matrix, row_norm);
+    norm_solution = std::fmax(norm_solution, std::fabs(solution[i]));
+    norm_right = std::fmax(norm_right, std::fabs(row[size]));
+  }
+  double scale = norm_matrix * norm_solution + norm_right;
+  return scale > 0 ? norm_remainder / scale : 0;
+}
+
+template <class T>
+Matrix<T> MixedPrecisionSolver::Coefficients_(Matrix<double> &matrix) {
+  int size = matrix.GetRows();
+  Matrix<T> result(size, size);
+  for (int i = 0; i < size; ++i) {
+    const double *source = matrix.GetRow(i);
+    T *destination = result.GetRow(i);
+    for (int j = 0; j < size; ++j) destination[j] = (T)source[j];
+  }
+  return result;
+}
+
+}  // namespace s21
@@ -0,0 +1,50 @@
+#ifndef SRC_ALGORITHMS_MIXEDPRECISIONSOLVER_H
+#define SRC_ALGORITHMS_MIXEDPRECISIONSOLVER_H
+
+#include <chrono>
+#include <vector>
+
+#include "../helpers/matrix.h"
+#include "LuDecomposition.h"
+
+namespace s21 {
+
+struct MixedPrecisionResult {
+  std::vector<double> solution;
+  int refinement_steps = 0;
+  double residual = 0;  //  normwise backward error of the solution
+  bool fell_back = false;
+  double time = 0;
+  double double_time = 0;  //  only measured on request
+  double speedup = 0;
+};
+
+//  Factors the augmented system once in float and refines the solution
+//  with residuals computed in double. If the refinement stops improving
+//  the system is solved again completely in double.
+class MixedPrecisionSolver {
+ public:
+  explicit MixedPrecisionSolver(int max_steps = 10, double tolerance = 1e-15);
+  ~MixedPrecisionSolver() = default;
+
+  MixedPrecisionResult Solve(Matrix<double> &matrix,
+                             bool measure_speedup = false);
+  bool GetError() { return error_; }
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  int max_steps_;
+  double tolerance_;
+  bool error_ = false;
+
+  template <class T>
+  static Matrix<T> Coefficients_(Matrix<double> &matrix);
+  bool SolveInDouble_(Matrix<double> &matrix, std::vector<double> &solution);
+  static double Residual_(Matrix<double> &matrix,
+                          const std::vector<double> &solution,
+                          std::vector<double> &remainder);
+};
+}  // namespace s21
+
+#endif  // SRC_ALGORITHMS_MIXEDPRECISIONSOLVER_H
@@ -0,0 +1,159 @@
+#include "SparseGaussAlgorithm.h"
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+
+namespace s21 {
+
+std::vector<double> SparseGaussAlgorithm::Solve(
+    const SparseMatrix<double> &matrix, const std::vector<double> &right) {
+  int size = matrix.GetRows();
+  if (size < 1 || matrix.GetCols() != size || (int)right.size() != size)
+    return {};
+  std::vector<int> order = ReverseCuthillMcKee(matrix);
+  std::vector<int> position(size);
+  for (int i = 0; i < size; ++i) position[order[i]] = i;
+
+  const std::vector<int> &row_start = matrix.GetRowStart();
+  const std::vector<int> &col_index = matrix.GetColIndex();
+  const std::vector<double> &values = matrix.GetValues();
+
+  std::vector<SparseRow> upper(size);
+  std::vector<double> work(size, 0), permuted_right(size);
+  std::vector<char> is_used(size, 0);
+  std::vector<int> pattern;
+  for (int i = 0; i < size; ++i) {
+    int row = order[i];
+    pattern.clear();
+    for (int k = row_start[row]; k < row_start[row + 1]; ++k) {
+      int col = position[col_index[k]];
+      work[col] = values[k];
+      is_used[col] = 1;
+      pattern.push_back(col);
+    }
+    permuted_right[i] = right[row];
+    EliminateRow_(upper, work, is_used, pattern, i, permuted_right);
+
+    double pivot = work[i];
+    if (pivot == 0) return {};
+    std::sort(pattern.begin(), pattern.end());
+    for (int col : pattern) {
+      if (col > i && work[col] != 0) {
+        upper[i].cols.push_back(col);
+        upper[i].values.push_back(work[col] / pivot);
+      }
+      work[col] = 0;
+      is_used[col] = 0;
+    }
+    permuted_right[i] /= pivot;
+  }
+
+  std::vector<double> permuted_result(size), result(size);
+  for (int i = size - 1; i >= 0; --i) {
+    double sum = permuted_right[i];
+    for (size_t k = 0; k < upper[i].cols.size(); ++k)
+      sum -= upper[i].values[k] * permuted_result[upper[i].cols[k]];
+    permuted_result[i] = sum;
+  }
+  for (int i = 0; i < size; ++i) result[order[i]] = permuted_result[i];
+  return result;
+}
+
+//  Subtracts the already normalized rows of U from the scattered row in
+//  increasing column order, new fill-in entries join the pattern on the fly
+void SparseGaussAlgorithm::EliminateRow_(const std::vector<SparseRow> &upper,
+                                         std::vector<double> &work,
+                                         std::vector<char> &is_used,
+                                         std::vector<int> &pattern, int row,
+                                         std::vector<double> &right) {
+  std::priority_queue<int, std::vector<int>, std::greater<int>> pending;
+  for (int col : pattern)
+    if (col < row) pending.push(col);
+  while (!pending.empty()) {
+    int k = pending.top();
+    pending.pop();
+    double factor = work[k];
+    if (factor == 0) continue;
+    const SparseRow &pivot_row = upper[k];
+    for (size_t j = 0; j < pivot_row.cols.size(); ++j) {
+      int col = pivot_row.cols[j];
+      if (!is_used[col]) {
+        is_used[col] = 1;
+        work[col] = 0;
+        pattern.push_back(col);
+        if (col < row) pending.push(col);
+      }
+      work[col] -= factor * pivot_row.values[j];
+    }
+    right[row] -= factor * right[k];
+    work[k] = 0;
+  }
+}
+
+std::vector<int> SparseGaussAlgorithm::ReverseCuthillMcKee(
+    const SparseMatrix<double> &matrix) {
+  std::vector<std::vector<int>> adjacency = BuildAdjacency_(matrix);
+  int size = (int)adjacency.size();
+  auto by_degree = [&adjacency](int a, int b) {
+    return adjacency[a].size() < adjacency[b].size() ||
+           (adjacency[a].size() == adjacency[b].size() && a < b);
+  };
+  std::vector<int> vertices(size), order;
+  for (int i = 0; i < size; ++i) vertices[i] = i;
+  std::sort(vertices.begin(), vertices.end(), by_degree);
+  order.reserve(size);
+  std::vector<char> visited(size, 0);
+  for (int start : vertices) {
+    if (visited[start]) continue;
+    visited[start] = 1;
+    size_t head = order.size();
+    order.push_back(start);
+    while (head < order.size()) {
+      int vertex = order[head++];
+      size_t first = order.size();
+      for (int next : adjacency[vertex]) {
+        if (!visited[next]) {
+          visited[next] = 1;
+          order.push_back(next);
+        }
+      }
+      std::sort(order.begin() + first, order.end(), by_degree);
+    }
+  }
+  std::reverse(order.begin(), order.end());
+  return order;
+}
+
+std::vector<std::vector<int>> SparseGaussAlgorithm::BuildAdjacency_(
+    const SparseMatrix<double> &matrix) {
+  int size = matrix.GetRows();
+  const std::vector<int> &row_start = matrix.GetRowStart();
+  const std::vector<int> &col_index = matrix.GetColIndex();
+  std::vector<std::vector<int>> adjacency(size);
+  for (int i = 0; i < size; ++i) {
+    for (int k = row_start[i]; k < row_start[i + 1]; ++k) {
+      int j = col_index[k];
+      if (j != i && j < size) {
+        adjacency[i].push_back(j);
+        adjacency[j].push_back(i);
+      }
+    }
+  }
+  for (auto &neighbours : adjacency) {
+    std::sort(neighbours.begin(), neighbours.end());
+    neighbours.erase(std::unique(neighbours.begin(), neighbours.end()),
+                     neighbours.end());
+  }
+  return adjacency;
+}
+
+std::vector<double> SparseGaussAlgorithm::SolveAugmented(
+    Matrix<double> &matrix) {
+  int size = matrix.GetRows();
+  if (size < 1 || matrix.GetCols() != size + 1) return {};
+  std::vector<double> right(size);
+  for (int i = 0; i < size; ++i) right[i] = matrix(i, size);
+  return Solve(SparseMatrix<double>(matrix, size), right);
+}
+}  // namespace s21
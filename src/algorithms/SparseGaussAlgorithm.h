@@ -0,0 +1,39 @@
+#ifndef SRC_ALGORITHMS_SPARSEGAUSSALGORITHM_H
+#define SRC_ALGORITHMS_SPARSEGAUSSALGORITHM_H
+
+#include <vector>
+
+#include "../helpers/matrix.h"
+#include "../helpers/sparse_matrix.h"
+
+namespace s21 {
+//  Direct solver for sparse systems. The unknowns are renumbered with the
+//  reverse Cuthill-McKee ordering to keep the fill-in close to the
+//  diagonal, then the rows are eliminated one by one touching only their
+//  non-zero entries. Like GaussAlgorithm no pivoting is done, a zero pivot
+//  makes Solve return an empty vector.
+class SparseGaussAlgorithm {
+ public:
+  static std::vector<double> Solve(const SparseMatrix<double> &matrix,
+                                   const std::vector<double> &right);
+  static std::vector<double> SolveAugmented(Matrix<double> &matrix);
+  static std::vector<int> ReverseCuthillMcKee(
+      const SparseMatrix<double> &matrix);
+
+ private:
+  struct SparseRow {
+    std::vector<int> cols;
+    std::vector<double> values;
+  };
+
+  static std::vector<std::vector<int>> BuildAdjacency_(
+      const SparseMatrix<double> &matrix);
+  static void EliminateRow_(const std::vector<SparseRow> &upper,
+                            std::vector<double> &work,
+                            std::vector<char> &is_used,
+                            std::vector<int> &pattern, int row,
+                            std::vector<double> &right);
+};
+}  // namespace s21
+
+#endif  // SRC_ALGORITHMS_SPARSEGAUSSALGORITHM_H
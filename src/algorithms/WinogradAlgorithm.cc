@@ -1,38 +1,91 @@
 #include "WinogradAlgorithm.h"
 
 namespace s21 {
-WinogradAlgorithm::WinogradAlgorithm(const Matrix<double> &first,
-                                     const Matrix<double> &second, int count)
+template <class T>
+WinogradAlgorithm<T>::WinogradAlgorithm(const Matrix<T> &first,
+                                        const Matrix<T> &second, int count)
     : first_matrix_(first), second_matrix_(second), count_(count) {
   half_cols_ = first_matrix_.GetCols() / 2;
 }
 
-Matrix<double> WinogradAlgorithm::GetResultMatrix(ExecutionType type,
-                                                  int number_of_thread) {
+template <class T>
+WinogradAlgorithm<T>::WinogradAlgorithm(ConstMatrixView<T> first,
+                                        ConstMatrixView<T> second, int count)
+    : first_matrix_(first.GetRows(), first.GetCols()),
+      second_matrix_(second.GetRows(), second.GetCols()),
+      count_(count) {
+  first.CopyTo(first_matrix_);
+  second.CopyTo(second_matrix_);
+  half_cols_ = first_matrix_.GetCols() / 2;
+}
+
+template <class T>
+Matrix<T> WinogradAlgorithm<T>::GetResultMatrix(ExecutionType type,
+                                                int number_of_thread) {
   CheckMatrixSize_();
-  if (!error_ && first_matrix_.GetCols() == 1)
+  overflow_ = false;
+  cancelled_ = false;
+  if (!error_ && !Cancelled_() && first_matrix_.GetCols() == 1)
     MulMatrixInOneColumn();
-  else if (!error_)
+  else if (!error_ && !cancelled_)
     PreparingForExecution_(type, number_of_thread);
-  return result_matrix_;
+  return cancelled_ ? Matrix<T>() : result_matrix_;
+}
+
+//  Only a poll that saw the token cancelled marks the run, a deadline that
+//  passes after the last row leaves a complete result alone
+template <class T>
+bool WinogradAlgorithm<T>::Cancelled_() {
+  if (!token_.IsCancelled()) return false;
+  cancelled_ = true;
+  return true;
 }
 
-void WinogradAlgorithm::CheckMatrixSize_() {
+template <class T>
+void WinogradAlgorithm<T>::CheckMatrixSize_() {
   error_ = first_matrix_.GetCols() != second_matrix_.GetRows();
 }
 
-void WinogradAlgorithm::MulMatrixInOneColumn() {
-  for (int i = 0; i < count_; i++) {
-    result_matrix_ = first_matrix_ * second_matrix_;
+//  Integer products go through Accumulator and StoreResult_, so a result
+//  that does not fit raises overflow_ like the Winograd paths do
+template <class T>
+void WinogradAlgorithm<T>::MulMatrixInOneColumn() {
+  if constexpr (std::is_floating_point_v<T>) {
+    for (int i = 0; i < count_ && !Cancelled_(); i++) {
+      result_matrix_ = first_matrix_ * second_matrix_;
+    }
+  } else {
+    if (result_matrix_.GetRows() != first_matrix_.GetRows() ||
+        result_matrix_.GetCols() != second_matrix_.GetCols())
+      result_matrix_ =
+          Matrix<T>(first_matrix_.GetRows(), second_matrix_.GetCols());
+    for (int n = 0; n < count_ && !Cancelled_(); n++) {
+      for (int i = 0; i < first_matrix_.GetRows(); i++) {
+        for (int j = 0; j < second_matrix_.GetCols(); j++) {
+          Accumulator sum = Accumulator();
+          for (int k = 0; k < first_matrix_.GetCols(); k++)
+            sum += (Accumulator)first_matrix_(i, k) * second_matrix_(k, j);
+          StoreResult_(sum, result_matrix_(i, j));
+        }
+      }
+    }
   }
 }
 
-void WinogradAlgorithm::PreparingForExecution_(ExecutionType type,
-                                               int number_of_thread) {
-  row_factor_ = vector<double>(first_matrix_.GetRows());
-  column_factor_ = vector<double>(second_matrix_.GetCols());
-  result_matrix_ =
-      Matrix<double>(first_matrix_.GetRows(), second_matrix_.GetCols());
+template <class T>
+void WinogradAlgorithm<T>::PreparingForExecution_(ExecutionType type,
+                                                  int number_of_thread) {
+  if (type == ExecutionType::AUTOTUNED_PARALLELISM) {
+    AutotunedExecution_();
+    return;
+  }
+  row_factor_ = vector<Accumulator>(first_matrix_.GetRows());
+  column_factor_ = vector<Accumulator>(second_matrix_.GetCols());
+  if (result_matrix_.GetRows() != first_matrix_.GetRows() ||
+      result_matrix_.GetCols() != second_matrix_.GetCols())
+    result_matrix_ = Matrix<T>(first_matrix_.GetRows(),
+                               second_matrix_.GetCols(),
+                               ResultPolicy_(type, number_of_thread));
   if (type == ExecutionType::WITHOUT_PARALLELISM) {
     AlgorithmExecutionFirstPart_(0, first_matrix_.GetRows(), 0,
                                  second_matrix_.GetCols());
@@ -44,143 +97,249 @@ void WinogradAlgorithm::PreparingForExecution_(ExecutionType type,
   }
 }
 
-void WinogradAlgorithm::AlgorithmExecutionFirstPart_(int start_row, int end_row,
-                                                     int start_col,
-                                                     int end_col) {
-  for (int i = 0; i < count_; i++) {
+//  Naive and blocked products accumulate in T, for int that could overflow
+//  where Winograd's 64-bit sums don't, so only floating point tries them
+template <class T>
+void WinogradAlgorithm<T>::AutotunedExecution_() {
+  std::vector<TunedConfig> candidates;
+  for (int variant = WINOGRAD_SERIAL; variant <= BLOCKED_GEMM; ++variant) {
+    if (variant >= NAIVE_MULTIPLICATION && !std::is_floating_point<T>::value)
+      break;
+    if (variant == WINOGRAD_CLASSICAL) {
+      for (int threads : Autotuner::ThreadCandidates())
+        candidates.push_back({variant, threads, 0, 0});
+    } else if (variant == BLOCKED_GEMM) {
+      for (int block : {32, 64, 128, 256})
+        candidates.push_back({variant, 1, block, 0});
+    } else {
+      candidates.push_back({variant, variant == WINOGRAD_PIPELINED ? 3 : 1,
+                            0, 0});
+    }
+  }
+  std::string key = Autotuner::MakeKey(
+      std::string("winograd/") + (std::is_same<T, int>::value     ? "int"
+                                  : std::is_same<T, float>::value ? "float"
+                                                                  : "double"),
+      {first_matrix_.GetRows(), first_matrix_.GetCols(),
+       second_matrix_.GetCols()});
+  //  Tuning runs ignore the token, an interrupted one would store a wrong
+  //  timing in the profile
+  CancellationToken token = std::move(token_);
+  token_ = CancellationToken();
+  TunedConfig best =
+      Autotuner::Select(key, candidates, [this](const TunedConfig &config) {
+        return Autotuner::Time([&]() { RunConfig_(config); });
+      });
+  token_ = std::move(token);
+  if (!Cancelled_()) RunConfig_(best);
+}
+
+template <class T>
+void WinogradAlgorithm<T>::RunConfig_(const TunedConfig &config) {
+  overflow_ = false;
+  if (config.variant == WINOGRAD_CLASSICAL) {
+    PreparingForExecution_(CLASSICAL_PARALLELISM, config.threads);
+  } else if (config.variant == WINOGRAD_PIPELINED) {
+    PreparingForExecution_(PIPELINED_PARALLELISM, config.threads);
+  } else if (config.variant == NAIVE_MULTIPLICATION) {
+    MulMatrixInOneColumn();
+  } else if (config.variant == BLOCKED_GEMM) {
+    if (result_matrix_.GetRows() != first_matrix_.GetRows() ||
+        result_matrix_.GetCols() != second_matrix_.GetCols())
+      result_matrix_ =
+          Matrix<T>(first_matrix_.GetRows(), second_matrix_.GetCols());
+    for (int i = 0; i < count_ && !Cancelled_(); i++)
+      Gemm<T>(T(1), ConstMatrixView<T>(first_matrix_),
+              ConstMatrixView<T>(second_matrix_), T(),
+              MatrixView<T>(result_matrix_), config.block);
+  } else {
+    PreparingForExecution_(WITHOUT_PARALLELISM, 1);
+  }
+}
+
+//  Result rows are first touched by the thread that computes them, the
+//  rest, including the arena, is up to the default policy
+template <class T>
+AllocationPolicy WinogradAlgorithm<T>::ResultPolicy_(ExecutionType type,
+                                                     int number_of_thread) {
+  AllocationPolicy policy = MatrixAllocator::GetDefaultPolicy();
+  if (type == ExecutionType::CLASSICAL_PARALLELISM)
+    policy.first_touch_threads = number_of_thread;
+  return policy;
+}
+
+template <class T>
+void WinogradAlgorithm<T>::AlgorithmExecutionFirstPart_(int start_row,
+                                                        int end_row,
+                                                        int start_col,
+                                                        int end_col) {
+  S21_TRACE_SCOPE("winograd factors");
+  for (int i = 0; i < count_ && !Cancelled_(); i++) {
     CalculateRowFactor_(start_row, end_row);
     CalculateColumnFactor_(start_col, end_col);
   }
 }
 
-void WinogradAlgorithm::AlgorithmExecutionSecondPart_(int start_row,
-                                                      int end_row) {
-  for (int i = 0; i < count_; i++) {
+template <class T>
+void WinogradAlgorithm<T>::AlgorithmExecutionSecondPart_(int start_row,
+                                                         int end_row) {
+  S21_TRACE_SCOPE("winograd products");
+  for (int i = 0; i < count_ && !Cancelled_(); i++) {
     CalculateResultMatrix_(start_row, end_row);
-    AddValueIfOdd_(start_row, end_row);
   }
 }
 
 //  check number of the threads in interface 2, 4, 6 ... 24
-void WinogradAlgorithm::ClassicalParallelismExecution(int number_of_thread) {
+template <class T>
+void WinogradAlgorithm<T>::ClassicalParallelismExecution(int number_of_thread) {
+  vector<int> placement = Topology::Get().Placement(number_of_thread);
   vector<thread> threads(number_of_thread);
   for (int i = 0; i < number_of_thread; i++) {
-    threads[i] = thread(&WinogradAlgorithm::AlgorithmExecutionFirstPart_, this,
-                        i * first_matrix_.GetRows() / number_of_thread,
-                        (i + 1) * first_matrix_.GetRows() / number_of_thread,
-                        i * second_matrix_.GetCols() / number_of_thread,
-                        (i + 1) * second_matrix_.GetCols() / number_of_thread);
+    threads[i] = Topology::StartThread(
+        placement[i], &WinogradAlgorithm<T>::AlgorithmExecutionFirstPart_,
+        this, i * first_matrix_.GetRows() / number_of_thread,
+        (i + 1) * first_matrix_.GetRows() / number_of_thread,
+        i * second_matrix_.GetCols() / number_of_thread,
+        (i + 1) * second_matrix_.GetCols() / number_of_thread);
   }
   for (int i = 0; i < number_of_thread; i++) threads[i].join();
 
   for (int i = 0; i < number_of_thread; i++) {
-    threads[i] = thread(&WinogradAlgorithm::AlgorithmExecutionSecondPart_, this,
-                        i * first_matrix_.GetRows() / number_of_thread,
-                        (i + 1) * first_matrix_.GetRows() / number_of_thread);
+    threads[i] = Topology::StartThread(
+        placement[i], &WinogradAlgorithm<T>::AlgorithmExecutionSecondPart_,
+        this, i * first_matrix_.GetRows() / number_of_thread,
+        (i + 1) * first_matrix_.GetRows() / number_of_thread);
   }
   for (int i = 0; i < number_of_thread; i++) threads[i].join();
 }
 
-void WinogradAlgorithm::PipelineParallelismExecution() {
-  thread th1(&WinogradAlgorithm::PipelineParallelismStageOne_, this);
-  thread th2(&WinogradAlgorithm::PipelineParallelismStageTwo_, this);
-  thread th3(&WinogradAlgorithm::PipelineParallelismStageThree_, this);
-  thread th4(&WinogradAlgorithm::PipelineParallelismStageFour_, this);
+template <class T>
+void WinogradAlgorithm<T>::PipelineParallelismExecution() {
+  vector<int> placement = Topology::Get().Placement(3);
+  thread th1 = Topology::StartThread(
+      placement[0], &WinogradAlgorithm<T>::PipelineParallelismStageOne_, this);
+  thread th2 = Topology::StartThread(
+      placement[1], &WinogradAlgorithm<T>::PipelineParallelismStageTwo_, this);
+  thread th3 = Topology::StartThread(
+      placement[2], &WinogradAlgorithm<T>::PipelineParallelismStageThree_,
+      this);
   th1.join();
   th2.join();
   th3.join();
-  th4.join();
 }
 
-void WinogradAlgorithm::CalculateRowFactor_(int start, int end) {
+template <class T>
+void WinogradAlgorithm<T>::CalculateRowFactor_(int start, int end) {
   for (int i = start; i < end; i++) {
-    row_factor_[i] = first_matrix_(i, 0) * first_matrix_(i, 1);
+    row_factor_[i] =
+        (Accumulator)first_matrix_(i, 0) * (Accumulator)first_matrix_(i, 1);
     for (int j = 1; j < half_cols_; j++)
-      row_factor_[i] += first_matrix_(i, 2 * j + 1) * first_matrix_(i, 2 * j);
+      row_factor_[i] += (Accumulator)first_matrix_(i, 2 * j + 1) *
+                        (Accumulator)first_matrix_(i, 2 * j);
   }
 }
 
-void WinogradAlgorithm::CalculateColumnFactor_(int start, int end) {
+template <class T>
+void WinogradAlgorithm<T>::CalculateColumnFactor_(int start, int end) {
   for (int i = start; i < end; i++) {
-    column_factor_[i] = second_matrix_(0, i) * second_matrix_(1, i);
+    column_factor_[i] =
+        (Accumulator)second_matrix_(0, i) * (Accumulator)second_matrix_(1, i);
     for (int j = 1; j < half_cols_; j++)
-      column_factor_[i] +=
-          second_matrix_(2 * j + 1, i) * second_matrix_(2 * j, i);
+      column_factor_[i] += (Accumulator)second_matrix_(2 * j + 1, i) *
+                           (Accumulator)second_matrix_(2 * j, i);
   }
 }
 
-void WinogradAlgorithm::CalculateResultMatrix_(int start, int end) {
-  for (int i = start; i < end; i++) {
+//  The last column of an odd inner dimension joins the sum before it is
+//  narrowed, so only the complete result is checked for overflow
+template <class T>
+void WinogradAlgorithm<T>::CalculateResultMatrix_(int start, int end) {
+  int cols = first_matrix_.GetCols();
+  bool odd = half_cols_ * 2 != cols;
+  for (int i = start; i < end && !Cancelled_(); i++) {
     for (int j = 0; j < second_matrix_.GetCols(); j++) {
-      result_matrix_(i, j) = -row_factor_[i] - column_factor_[j];
+      Accumulator sum = -row_factor_[i] - column_factor_[j];
       for (int k = 0; k < half_cols_; k++) {
-        result_matrix_(i, j) +=
-            (first_matrix_(i, 2 * k) + second_matrix_(2 * k + 1, j)) *
-            (first_matrix_(i, 2 * k + 1) + second_matrix_(2 * k, j));
+        sum += ((Accumulator)first_matrix_(i, 2 * k) +
+                second_matrix_(2 * k + 1, j)) *
+               ((Accumulator)first_matrix_(i, 2 * k + 1) +
+                second_matrix_(2 * k, j));
       }
+      if (odd)
+        sum += (Accumulator)first_matrix_(i, cols - 1) *
+               second_matrix_(cols - 1, j);
+      StoreResult_(sum, result_matrix_(i, j));
     }
   }
 }
 
-void WinogradAlgorithm::AddValueIfOdd_(int start, int end) {
-  int cols = first_matrix_.GetCols();
-  if (half_cols_ * 2 != cols) {
-    for (int i = start; i < end; i++)
-      for (int j = 0; j < second_matrix_.GetCols(); j++)
-        result_matrix_(i, j) +=
-            first_matrix_(i, cols - 1) * second_matrix_(cols - 1, j);
+//  Narrowing back to T, integer results that do not fit raise the overflow
+//  flag instead of silently wrapping
+template <class T>
+void WinogradAlgorithm<T>::StoreResult_(Accumulator value, T &target) {
+  if constexpr (std::is_integral_v<T>) {
+    if (value > std::numeric_limits<T>::max() ||
+        value < std::numeric_limits<T>::min())
+      overflow_ = true;
   }
+  target = (T)value;
 }
 
-void WinogradAlgorithm::PipelineParallelismStageOne_() {
+template <class T>
+void WinogradAlgorithm<T>::PipelineParallelismStageOne_() {
   for (int i = 0; i < count_; i++) {
     stage_one = false;
-    mutex_one.lock();
-    CalculateRowFactor_(0, first_matrix_.GetRows());
+    S21_TRACE_LOCK(mutex_one, "winograd stage one lock");
+    {
+      S21_TRACE_SCOPE("winograd row factors");
+      CalculateRowFactor_(0, first_matrix_.GetRows());
+    }
     mutex_one.unlock();
     stage_one = true;
     cv_one.notify_all();
   }
 }
 
-void WinogradAlgorithm::PipelineParallelismStageTwo_() {
+template <class T>
+void WinogradAlgorithm<T>::PipelineParallelismStageTwo_() {
   for (int i = 0; i < count_; i++) {
     stage_two = false;
-    mutex_two.lock();
-    CalculateColumnFactor_(0, second_matrix_.GetCols());
+    S21_TRACE_LOCK(mutex_two, "winograd stage two lock");
+    {
+      S21_TRACE_SCOPE("winograd column factors");
+      CalculateColumnFactor_(0, second_matrix_.GetCols());
+    }
     mutex_two.unlock();
     stage_two = true;
     cv_two.notify_all();
   }
 }
 
-void WinogradAlgorithm::PipelineParallelismStageThree_() {
+template <class T>
+void WinogradAlgorithm<T>::PipelineParallelismStageThree_() {
   for (int i = 0; i < count_; i++) {
-    unique_lock<mutex> ul_one(mutex_one);
-    unique_lock<mutex> ul_two(mutex_two);
-
-    cv_one.wait(ul_one, [=]() { return stage_one; });
-    cv_two.wait(ul_two, [=]() { return stage_two; });
+    unique_lock<mutex> ul_one(mutex_one, std::defer_lock);
+    unique_lock<mutex> ul_two(mutex_two, std::defer_lock);
+    {
+      S21_TRACE_WAIT("winograd stage three wait");
+      ul_one.lock();
+      ul_two.lock();
+      cv_one.wait(ul_one, [=]() { return stage_one; });
+      cv_two.wait(ul_two, [=]() { return stage_two; });
+    }
 
-    stage_three = false;
-    mutex_three.lock();
-    CalculateResultMatrix_(0, first_matrix_.GetRows());
-    mutex_three.unlock();
-    stage_three = true;
+    {
+      S21_TRACE_SCOPE("winograd result matrix");
+      CalculateResultMatrix_(0, first_matrix_.GetRows());
+    }
 
     ul_one.unlock();
     ul_two.unlock();
-    cv_three.notify_all();
-  }
-}
-
-void WinogradAlgorithm::PipelineParallelismStageFour_() {
-  for (int i = 0; i < count_; i++) {
-    unique_lock<mutex> ul_three(mutex_three);
-    cv_three.wait(ul_three, [=]() { return stage_three; });
-    AddValueIfOdd_(0, first_matrix_.GetRows());
-    ul_three.unlock();
   }
 }
 
 }  // namespace s21
+
+template class s21::WinogradAlgorithm<double>;
+template class s21::WinogradAlgorithm<float>;
+template class s21::WinogradAlgorithm<int>;
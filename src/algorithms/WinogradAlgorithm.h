@@ -1,11 +1,20 @@
 #ifndef SRC_ALGORITHMS_WINOGRADALGORITHM_H
 #define SRC_ALGORITHMS_WINOGRADALGORITHM_H
 
+#include <atomic>
+#include <condition_variable>
+#include <limits>
 #include <mutex>
 #include <thread>
+#include <type_traits>
 #include <vector>
 
+#include "../helpers/autotuner.h"
+#include "../helpers/cancellation.h"
 #include "../helpers/matrix.h"
+#include "../helpers/matrix_view.h"
+#include "../helpers/topology.h"
+#include "../helpers/trace.h"
 
 using std::condition_variable;
 using std::mutex;
@@ -18,31 +27,73 @@ namespace s21 {
 enum ExecutionType {
   WITHOUT_PARALLELISM,
   CLASSICAL_PARALLELISM,
-  PIPELINED_PARALLELISM
+  PIPELINED_PARALLELISM,
+  //  Whichever of the above, naive MulMatrix or the blocked Gemm with
+  //  whatever thread count and panel size the Autotuner found fastest for
+  //  this shape class, number_of_thread is ignored
+  AUTOTUNED_PARALLELISM
 };
 
+//  TunedConfig::variant of the Winograd autotuner
+enum WinogradVariant {
+  WINOGRAD_SERIAL,
+  WINOGRAD_CLASSICAL,
+  WINOGRAD_PIPELINED,
+  NAIVE_MULTIPLICATION,
+  BLOCKED_GEMM
+};
+
+//  Integer products are summed in 64 bits, floating point ones in T itself
+template <class T>
+struct WinogradAccumulator {
+  using type = T;
+};
+
+template <>
+struct WinogradAccumulator<int> {
+  using type = long long;
+};
+
+template <class T>
 class WinogradAlgorithm {
  public:
-  WinogradAlgorithm(const Matrix<double> &, const Matrix<double> &,
+  using Accumulator = typename WinogradAccumulator<T>::type;
+
+  WinogradAlgorithm(const Matrix<T> &, const Matrix<T> &, int count = 1);
+  //  Operands may be blocks of larger matrices, they are copied in once
+  WinogradAlgorithm(ConstMatrixView<T> first, ConstMatrixView<T> second,
                     int count = 1);
   ~WinogradAlgorithm() = default;
 
-  Matrix<double> GetResultMatrix(ExecutionType type, int number_of_thread = 1);
-  bool GetError() { return error_; }
+  Matrix<T> GetResultMatrix(ExecutionType type, int number_of_thread = 1);
+  //  Polled before every row of the result, a cancelled run returns an
+  //  empty matrix with GetError() and GetCancelled() set
+  void SetCancellation(CancellationToken token) { token_ = std::move(token); }
+  bool GetError() { return error_ || overflow_ || cancelled_; }
+  bool GetOverflow() { return overflow_; }
+  bool GetCancelled() { return cancelled_; }
 
  private:
-  Matrix<double> first_matrix_;
-  Matrix<double> second_matrix_;
-  Matrix<double> result_matrix_;
+  Matrix<T> first_matrix_;
+  Matrix<T> second_matrix_;
+  Matrix<T> result_matrix_;
 
-  vector<double> row_factor_;
-  vector<double> column_factor_;
+  vector<Accumulator> row_factor_;
+  vector<Accumulator> column_factor_;
 
   int count_;
   int half_cols_;
   bool error_ = false;
+  std::atomic<bool> overflow_{false};
+  CancellationToken token_;
+  std::atomic<bool> cancelled_{false};
 
+  bool Cancelled_();
   void PreparingForExecution_(ExecutionType type, int number_of_thread);
+  void AutotunedExecution_();
+  void RunConfig_(const TunedConfig &config);
+  static AllocationPolicy ResultPolicy_(ExecutionType type,
+                                        int number_of_thread);
   void ClassicalParallelismExecution(int number_of_thread);
   void PipelineParallelismExecution();
   void AlgorithmExecutionFirstPart_(int start_row, int end_row, int start_col,
@@ -53,15 +104,14 @@ class WinogradAlgorithm {
   void CalculateRowFactor_(int start, int end);
   void CalculateColumnFactor_(int start, int end);
   void CalculateResultMatrix_(int start, int end);
-  void AddValueIfOdd_(int start, int end);
+  void StoreResult_(Accumulator value, T &target);
 
-  bool stage_one = false, stage_two = false, stage_three = false;
-  mutex mutex_one, mutex_two, mutex_three;
-  condition_variable cv_one, cv_two, cv_three;
+  bool stage_one = false, stage_two = false;
+  mutex mutex_one, mutex_two;
+  condition_variable cv_one, cv_two;
   void PipelineParallelismStageOne_();
   void PipelineParallelismStageTwo_();
   void PipelineParallelismStageThree_();
-  void PipelineParallelismStageFour_();
 };
 
 }  // namespace s21
@@ -0,0 +1,152 @@
+#include "WinogradBatch.h"
+
+namespace s21 {
+template <class T>
+WinogradBatch<T>::WinogradBatch(int rows, int inner, int cols)
+    : rows_(rows), inner_(inner), cols_(cols) {
+  error_ = rows_ < 1 || inner_ < 1 || cols_ < 1;
+  half_inner_ = inner_ / 2;
+}
+
+//  One dispatch for the whole batch: every thread gets a contiguous range
+//  of matrices and reuses its own workspace for all of them.
+template <class T>
+void WinogradBatch<T>::Multiply(BatchOperand<T> first, BatchOperand<T> second,
+                                T *result, long result_stride, int batch_count,
+                                int number_of_thread) {
+  overflow_ = false;
+  if (error_ || batch_count < 1) return;
+  int groups = (batch_count + kLanes - 1) / kLanes;
+  if (number_of_thread > groups) number_of_thread = groups;
+  if (number_of_thread <= 1) {
+    ExecuteRange_(first, second, result, result_stride, 0, batch_count);
+    return;
+  }
+  vector<int> placement = Topology::Get().Placement(number_of_thread);
+  vector<thread> threads(number_of_thread);
+  for (int i = 0; i < number_of_thread; i++) {
+    int start = i * groups / number_of_thread * kLanes;
+    int end = (i + 1) * groups / number_of_thread * kLanes;
+    if (end > batch_count) end = batch_count;
+    threads[i] = Topology::StartThread(
+        placement[i], &WinogradBatch<T>::ExecuteRange_, this, first, second,
+        result, result_stride, start, end);
+  }
+  for (int i = 0; i < number_of_thread; i++) threads[i].join();
+}
+
+template <class T>
+void WinogradBatch<T>::ExecuteRange_(BatchOperand<T> first,
+                                     BatchOperand<T> second, T *result,
+                                     long result_stride, int start, int end) {
+  Workspace ws;
+  ws.first.resize((size_t)rows_ * inner_ * kLanes);
+  ws.second.resize((size_t)inner_ * cols_ * kLanes);
+  ws.result.resize((size_t)rows_ * cols_ * kLanes);
+  ws.row_factor.resize((size_t)rows_ * kLanes);
+  ws.column_factor.resize((size_t)cols_ * kLanes);
+  for (int i = start; i < end; i += kLanes) {
+    int lanes = end - i < kLanes ? end - i : kLanes;
+    PackLanes_(first, i, lanes, rows_ * inner_, ws.first);
+    PackLanes_(second, i, lanes, inner_ * cols_, ws.second);
+    CalculateFactors_(ws);
+    CalculateResultMatrix_(ws);
+    UnpackLanes_(ws.result, result, result_stride, i, lanes);
+  }
+}
+
+//  Struct-of-arrays packing: element e of lane l lands at e * kLanes + l,
+//  unused lanes of the last group are zeroed.
+template <class T>
+void WinogradBatch<T>::PackLanes_(const BatchOperand<T> &operand, int start,
+                                  int lanes, int elements,
+                                  vector<Accumulator> &packed) {
+  for (int l = 0; l < kLanes; l++) {
+    if (l < lanes) {
+      const T *source = operand.data + (start + l) * operand.stride;
+      for (int e = 0; e < elements; e++) packed[e * kLanes + l] = source[e];
+    } else {
+      for (int e = 0; e < elements; e++) packed[e * kLanes + l] = 0;
+    }
+  }
+}
+
+template <class T>
+void WinogradBatch<T>::UnpackLanes_(const vector<Accumulator> &packed,
+                                    T *result, long result_stride, int start,
+                                    int lanes) {
+  int elements = rows_ * cols_;
+  for (int l = 0; l < lanes; l++) {
+    T *destination = result + (start + l) * result_stride;
+    for (int e = 0; e < elements; e++) {
+      Accumulator value = packed[e * kLanes + l];
+      if constexpr (std::is_integral_v<T>) {
+        if (value > std::numeric_limits<T>::max() ||
+            value < std::numeric_limits<T>::min())
+          overflow_ = true;
+      }
+      destination[e] = (T)value;
+    }
+  }
+}
+
+template <class T>
+void WinogradBatch<T>::CalculateFactors_(Workspace &ws) {
+  const Accumulator *a = ws.first.data();
+  const Accumulator *b = ws.second.data();
+  for (int i = 0; i < rows_; i++) {
+    Accumulator *factor = &ws.row_factor[i * kLanes];
+    for (int l = 0; l < kLanes; l++) factor[l] = 0;
+    for (int k = 0; k < half_inner_; k++) {
+      const Accumulator *even = a + (i * inner_ + 2 * k) * kLanes;
+      const Accumulator *odd = even + kLanes;
+      for (int l = 0; l < kLanes; l++) factor[l] += even[l] * odd[l];
+    }
+  }
+  for (int j = 0; j < cols_; j++) {
+    Accumulator *factor = &ws.column_factor[j * kLanes];
+    for (int l = 0; l < kLanes; l++) factor[l] = 0;
+    for (int k = 0; k < half_inner_; k++) {
+      const Accumulator *even = b + (2 * k * cols_ + j) * kLanes;
+      const Accumulator *odd = even + cols_ * kLanes;
+      for (int l = 0; l < kLanes; l++) factor[l] += even[l] * odd[l];
+    }
+  }
+}
+
+template <class T>
+void WinogradBatch<T>::CalculateResultMatrix_(Workspace &ws) {
+  const Accumulator *a = ws.first.data();
+  const Accumulator *b = ws.second.data();
+  bool is_odd = half_inner_ * 2 != inner_;
+  for (int i = 0; i < rows_; i++) {
+    const Accumulator *row_factor = &ws.row_factor[i * kLanes];
+    for (int j = 0; j < cols_; j++) {
+      const Accumulator *column_factor = &ws.column_factor[j * kLanes];
+      Accumulator sum[kLanes];
+      for (int l = 0; l < kLanes; l++)
+        sum[l] = -row_factor[l] - column_factor[l];
+      for (int k = 0; k < half_inner_; k++) {
+        const Accumulator *a_even = a + (i * inner_ + 2 * k) * kLanes;
+        const Accumulator *a_odd = a_even + kLanes;
+        const Accumulator *b_even = b + (2 * k * cols_ + j) * kLanes;
+        const Accumulator *b_odd = b_even + cols_ * kLanes;
+        for (int l = 0; l < kLanes; l++)
+          sum[l] += (a_even[l] + b_odd[l]) * (a_odd[l] + b_even[l]);
+      }
+      if (is_odd) {
+        const Accumulator *a_last = a + (i * inner_ + inner_ - 1) * kLanes;
+        const Accumulator *b_last = b + ((inner_ - 1) * cols_ + j) * kLanes;
+        for (int l = 0; l < kLanes; l++) sum[l] += a_last[l] * b_last[l];
+      }
+      Accumulator *destination = &ws.result[(i * cols_ + j) * kLanes];
+      for (int l = 0; l < kLanes; l++) destination[l] = sum[l];
+    }
+  }
+}
+
+}  // namespace s21
+
+template class s21::WinogradBatch<double>;
+template class s21::WinogradBatch<float>;
+template class s21::WinogradBatch<int>;
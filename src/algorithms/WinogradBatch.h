@@ -0,0 +1,64 @@
+#ifndef SRC_ALGORITHMS_WINOGRADBATCH_H
+#define SRC_ALGORITHMS_WINOGRADBATCH_H
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "WinogradAlgorithm.h"
+
+using std::thread;
+using std::vector;
+
+namespace s21 {
+
+//  Strided-batch layout: matrix number i of a batch starts at
+//  data + i * stride and is stored row-major without padding.
+template <class T>
+struct BatchOperand {
+  const T *data;
+  long stride;
+};
+
+template <class T>
+class WinogradBatch {
+ public:
+  using Accumulator = typename WinogradAccumulator<T>::type;
+
+  WinogradBatch(int rows, int inner, int cols);
+  ~WinogradBatch() = default;
+
+  void Multiply(BatchOperand<T> first, BatchOperand<T> second, T *result,
+                long result_stride, int batch_count, int number_of_thread = 1);
+  bool GetError() { return error_ || overflow_; }
+  bool GetOverflow() { return overflow_; }
+
+ private:
+  //  Number of matrices packed side by side, one per lane of a 256-bit
+  //  register of Accumulator: 8 for float, 4 for double and for int.
+  //  Int operands are widened to 64 bits so the sums cannot wrap, and AVX2
+  //  has no 64-bit multiply, so int gains nothing from SIMD here
+  static constexpr int kLanes = 32 / sizeof(Accumulator);
+
+  struct Workspace {
+    vector<Accumulator> first, second, result;
+    vector<Accumulator> row_factor, column_factor;
+  };
+
+  int rows_, inner_, cols_, half_inner_;
+  bool error_ = false;
+  std::atomic<bool> overflow_{false};
+
+  void ExecuteRange_(BatchOperand<T> first, BatchOperand<T> second, T *result,
+                     long result_stride, int start, int end);
+  void PackLanes_(const BatchOperand<T> &operand, int start, int lanes,
+                  int elements, vector<Accumulator> &packed);
+  void UnpackLanes_(const vector<Accumulator> &packed, T *result,
+                    long result_stride, int start, int lanes);
+  void CalculateFactors_(Workspace &ws);
+  void CalculateResultMatrix_(Workspace &ws);
+};
+
+}  // namespace s21
+
+#endif  //  SRC_ALGORITHMS_WINOGRADBATCH_H
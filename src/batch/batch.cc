@@ -0,0 +1,417 @@
+#include "batch.h"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <utility>
+
+#include "../benchmark/benchmark.h"
+
+namespace s21 {
+namespace {
+double SecondsSince(std::chrono::steady_clock::time_point start_time) {
+  std::chrono::duration<double> duration =
+      std::chrono::steady_clock::now() - start_time;
+  return duration.count();
+}
+}  // namespace
+
+bool BatchRunner::ParseJob(const std::string &text, BatchJob &job,
+                           std::string &error) {
+  std::istringstream tokens(text);
+  std::string token;
+  if (!(tokens >> job.algorithm)) {
+    error = "empty job";
+    return false;
+  }
+  size_t inputs = job.algorithm == "winograd" ? 2 : 1;
+  if (job.algorithm != "winograd" && job.algorithm != "gauss" &&
+      job.algorithm != "ant") {
+    error = "unknown algorithm " + job.algorithm;
+    return false;
+  }
+  while (tokens >> token) {
+    size_t equal = token.find('=');
+    if (equal == std::string::npos) {
+      job.inputs.push_back(token);
+      continue;
+    }
+    std::string key = token.substr(0, equal), value = token.substr(equal + 1);
+    try {
+      if (key == "mode") {
+        job.mode = value;
+      } else if (key == "threads") {
+        job.threads = std::stoi(value);
+      } else if (key == "repeat") {
+        job.repeat = std::stoi(value);
+      } else {
+        error = "unknown option " + key;
+        return false;
+      }
+    } catch (std::exception &) {
+      error = "wrong value for " + key;
+      return false;
+    }
+  }
+  if (job.inputs.size() != inputs) {
+    error = job.algorithm + " needs " + std::to_string(inputs) + " input" +
+            (inputs > 1 ? "s" : "");
+    return false;
+  }
+  if (job.repeat < 1) job.repeat = 1;
+  return true;
+}
+
+bool BatchRunner::LoadJobFile(const std::string &path, std::string &error) {
+  std::ifstream file(path);
+  if (!file.is_open()) {
+    error = "can't open " + path;
+    return false;
+  }
+  std::string line;
+  for (int number = 1; std::getline(file, line); ++number) {
+    size_t first = line.find_first_not_of(" \t\r");
+    if (first == std::string::npos || line[first] == '#') continue;
+    BatchJob job;
+    job.line = number;
+    if (!ParseJob(line, job, error)) {
+      error = path + ":" + std::to_string(number) + ": " + error;
+      return false;
+    }
+    jobs_.push_back(job);
+  }
+  return true;
+}
+
+void BatchRunner::Run(std::ostream *progress) {
+  results_.clear();
+  for (size_t i = 0; i < jobs_.size(); ++i) {
+    const BatchJob &job = jobs_[i];
+    BatchResult base;
+    base.job = (int)i;
+    base.algorithm = job.algorithm;
+    base.repeat = job.repeat;
+    for (size_t j = 0; j < job.inputs.size(); ++j)
+      base.inputs += (j ? "+" : "") + job.inputs[j];
+    if (progress)
+      *progress << "[" << i + 1 << "/" << jobs_.size() << "] "
+                << job.algorithm << " " << base.inputs << std::endl;
+    if (job.algorithm == "winograd")
+      RunWinograd_(job, base);
+    else if (job.algorithm == "gauss")
+      RunGauss_(job, base);
+    else
+      RunAnt_(job, base);
+  }
+  MatrixAllocator::ClearArena();
+}
+
+//  random:ROWSxCOLS[:SEED] uses the generator of the benchmark matching the
+//  algorithm, so a random system is solvable and a random graph complete.
+//  Both of these only take the row count.
+bool BatchRunner::LoadInput_(const std::string &algorithm,
+                             const std::string &input, Matrix<double> &matrix,
+                             std::string &error, MatrixStructure *structure,
+                             LinearSystem *sparse) {
+  if (input.compare(0, 7, "random:") != 0) {
+    if (!std::ifstream(input).is_open()) {
+      error = "can't open " + input;
+      return false;
+    }
+    MatrixParser parser;
+    if (sparse) {
+      parser.LoadSystemFromFile(input, *sparse, GaussAlgorithm::kSparseMinRows);
+      matrix = std::move(sparse->dense);
+    } else {
+      matrix = parser.LoadMatrixFromFile(input);
+    }
+    if (parser.GetError() ||
+        (matrix.GetRows() == 0 && !(sparse && sparse->is_sparse))) {
+      error = "can't parse " + input;
+      return false;
+    }
+    if (structure) *structure = parser.GetStructure();
+    return true;
+  }
+  int rows = 0, cols = 0;
+  unsigned seed = 42;
+  char by = 0, colon = 0;
+  std::istringstream spec(input.substr(7));
+  if (!(spec >> rows >> by >> cols) || by != 'x' || rows < 1 || cols < 1) {
+    error = "wrong random input " + input;
+    return false;
+  }
+  if (spec >> colon && !(colon == ':' && spec >> seed)) {
+    error = "wrong random input " + input;
+    return false;
+  }
+  if (algorithm == "gauss")
+    matrix = Benchmark::RandomSystem(rows, seed);
+  else if (algorithm == "ant")
+    matrix = Benchmark::RandomGraph(rows, seed);
+  else
+    matrix = Benchmark::RandomMatrix(rows, cols, seed);
+  return true;
+}
+
+std::vector<std::string> BatchRunner::Modes_(
+    const BatchJob &job, const std::vector<std::string> &all) {
+  if (job.mode == "all") return all;
+  return {job.mode};
+}
+
+void BatchRunner::RunWinograd_(const BatchJob &job, BatchResult base) {
+  Matrix<double> first, second;
+  auto start_time = std::chrono::steady_clock::now();
+  if (!LoadInput_(job.algorithm, job.inputs[0], first, base.error) ||
+      !LoadInput_(job.algorithm, job.inputs[1], second, base.error)) {
+    results_.push_back(base);
+    return;
+  }
+  base.load_seconds = SecondsSince(start_time);
+  WinogradAlgorithm<double> algorithm(first, second, job.repeat);
+  int threads = job.threads > 0 ? job.threads : Topology::Get().GetMaxThreads();
+  for (const std::string &mode :
+       Modes_(job, {"serial", "classical", "pipelined", "autotuned"})) {
+    BatchResult result = base;
+    result.mode = mode;
+    ExecutionType type = WITHOUT_PARALLELISM;
+    result.threads = 1;
+    if (mode == "classical") {
+      type = CLASSICAL_PARALLELISM;
+      result.threads = threads;
+    } else if (mode == "pipelined") {
+      type = PIPELINED_PARALLELISM;
+      result.threads = 3;
+    } else if (mode == "autotuned") {
+      type = AUTOTUNED_PARALLELISM;
+      result.threads = 0;
+    } else if (mode != "serial") {
+      result.error = "unknown mode " + mode;
+      results_.push_back(result);
+      continue;
+    }
+    ResultKey key = ResultCache::MakeKey("winograd", {&first, &second}, mode);
+    Matrix<double> product;
+    start_time = std::chrono::steady_clock::now();
+    result.cached = ResultCache::Lookup(key, product);
+    if (!result.cached) {
+      product = algorithm.GetResultMatrix(type, threads);
+      if (!algorithm.GetError()) ResultCache::Store(key, product);
+    }
+    result.seconds = SecondsSince(start_time);
+    if (!result.cached && algorithm.GetError()) {
+      result.error = "incorrect matrix size";
+    } else {
+      result.rows = product.GetRows();
+      result.cols = product.GetCols();
+      bool keep = (long long)result.rows * result.cols <= matrix_limit_;
+      for (int i = 0; i < result.rows; ++i)
+        for (int j = 0; j < result.cols; ++j) {
+          result.checksum += product(i, j);
+          if (keep) result.values.push_back(product(i, j));
+        }
+    }
+    results_.push_back(result);
+  }
+}
+
+void BatchRunner::RunGauss_(const BatchJob &job, BatchResult base) {
+  Matrix<double> system;
+  MatrixStructure structure;
+  LinearSystem sparse;
+  auto start_time = std::chrono::steady_clock::now();
+  if (!LoadInput_(job.algorithm, job.inputs[0], system, base.error,
+                  &structure, &sparse)) {
+    results_.push_back(base);
+    return;
+  }
+  //  Found once here, not again in every repetition of every mode
+  if (!sparse.is_sparse && !structure.IsKnown())
+    structure = MatrixStructure::Scan(system);
+  base.load_seconds = SecondsSince(start_time);
+  for (const std::string &mode :
+       Modes_(job, {"serial", "parallel", "autotuned"})) {
+    BatchResult result = base;
+    result.mode = mode;
+    //  A sparse system has one solver whatever the mode
+    result.threads = sparse.is_sparse ? 1
+                     : mode == "parallel"
+                         ? (job.threads > 0
+                                ? job.threads
+                                : GaussAlgorithm::GetNumberOfThreads(system))
+                     : mode == "autotuned" ? 0
+                                           : 1;
+    if (mode != "serial" && mode != "parallel" && mode != "autotuned") {
+      result.error = "unknown mode " + mode;
+    } else if (!sparse.is_sparse && !GaussAlgorithm::CheckGaussMatrix(system)) {
+      result.error = "incorrect system";
+    } else {
+      ResultKey key =
+          sparse.is_sparse
+              ? ResultCache::MakeKey("gauss", sparse.coefficients,
+                                     sparse.right, mode)
+              : ResultCache::MakeKey("gauss", {&system}, mode);
+      std::vector<double> solution;
+      start_time = std::chrono::steady_clock::now();
+      result.cached = ResultCache::Lookup(key, solution);
+      result.seconds = SecondsSince(start_time);
+      for (int i = 0; !result.cached && i < job.repeat; ++i) {
+        //  The dense copy is only needed by the solvers that work in place
+        Matrix<double> copy(sparse.is_sparse ? Matrix<double>() : system);
+        start_time = std::chrono::steady_clock::now();
+        if (sparse.is_sparse)
+          solution =
+              GaussAlgorithm::GaussSparse(sparse.coefficients, sparse.right);
+        else if (mode == "serial")
+          solution = GaussAlgorithm::GaussWithoutParallelism(copy, structure);
+        else if (mode == "parallel")
+          solution = GaussAlgorithm::GaussWithParallelism(copy, structure,
+                                                          result.threads);
+        else
+          solution = GaussAlgorithm::GaussAutotuned(copy, structure);
+        result.seconds += SecondsSince(start_time);
+      }
+      if (!result.cached) ResultCache::Store(key, solution);
+      result.rows = (int)solution.size();
+      result.cols = 1;
+      for (double value : solution) result.checksum += value;
+      result.values = solution;
+    }
+    results_.push_back(result);
+  }
+}
+
+void BatchRunner::RunAnt_(const BatchJob &job, BatchResult base) {
+  Matrix<double> graph;
+  auto start_time = std::chrono::steady_clock::now();
+  if (!LoadInput_(job.algorithm, job.inputs[0], graph, base.error)) {
+    results_.push_back(base);
+    return;
+  }
+  base.load_seconds = SecondsSince(start_time);
+  for (const std::string &mode :
+       Modes_(job, {"serial", "parallel", "autotuned"})) {
+    BatchResult result = base;
+    result.mode = mode;
+    result.threads = mode == "parallel" ? (job.threads > 0 ? job.threads : 4)
+                     : mode == "autotuned" ? 0
+                                           : 1;
+    if (mode != "serial" && mode != "parallel" && mode != "autotuned") {
+      result.error = "unknown mode " + mode;
+      results_.push_back(result);
+      continue;
+    }
+    //  Stored as the distance followed by the tour
+    ResultKey key = ResultCache::MakeKey(
+        "ant", {&graph}, mode + "/" + std::to_string(job.repeat));
+    std::vector<double> cached;
+    AntAlgorithm algorithm(graph, job.repeat);
+    TsmResult tour;
+    start_time = std::chrono::steady_clock::now();
+    result.cached = ResultCache::Lookup(key, cached);
+    if (result.cached) {
+      tour.distance = cached[0];
+      tour.vertices.assign(cached.begin() + 1, cached.end());
+    } else {
+      tour = mode == "serial" ? algorithm.GetResult(false)
+             : mode == "parallel"
+                 ? algorithm.GetResultWithParallelism(result.threads)
+                 : algorithm.GetResultAutotuned();
+    }
+    result.seconds = SecondsSince(start_time);
+    GraphError error = algorithm.GetError();
+    if (!result.cached &&
+        (error == GRAPH_SMALL || error == GRAPH_INCOMPLETE)) {
+      result.error = "graph can't be incomplete or smaller than 3x3";
+    } else {
+      if (!result.cached) {
+        cached.assign(1, tour.distance);
+        cached.insert(cached.end(), tour.vertices.begin(),
+                      tour.vertices.end());
+        ResultCache::Store(key, cached);
+      }
+      result.rows = (int)tour.vertices.size();
+      result.cols = 1;
+      result.checksum = tour.distance;
+      result.values.assign(tour.vertices.begin(), tour.vertices.end());
+    }
+    results_.push_back(result);
+  }
+}
+
+bool BatchRunner::WriteJson(const std::string &path) const {
+  if (path == "-") {
+    WriteJson(std::cout);
+    return (bool)std::cout;
+  }
+  std::ofstream file(path);
+  if (!file.is_open()) return false;
+  WriteJson(file);
+  return (bool)file;
+}
+
+bool BatchRunner::WriteCsv(const std::string &path) const {
+  if (path == "-") {
+    WriteCsv(std::cout);
+    return (bool)std::cout;
+  }
+  std::ofstream file(path);
+  if (!file.is_open()) return false;
+  WriteCsv(file);
+  return (bool)file;
+}
+
+//  checksum is the tour length for ant, values the tour itself
+void BatchRunner::WriteJson(std::ostream &out) const {
+  out << std::setprecision(17) << "{\"results\": [";
+  for (size_t i = 0; i < results_.size(); ++i) {
+    const BatchResult &result = results_[i];
+    out << (i ? ",\n" : "\n") << "  {\"job\": " << result.job
+        << ", \"algorithm\": \"" << result.algorithm << "\", \"mode\": \""
+        << Escape_(result.mode) << "\", \"inputs\": \""
+        << Escape_(result.inputs) << "\", \"threads\": " << result.threads
+        << ", \"repeat\": " << result.repeat
+        << ", \"load_seconds\": " << result.load_seconds
+        << ", \"seconds\": " << result.seconds
+        << ", \"cached\": " << (result.cached ? "true" : "false")
+        << ", \"status\": \""
+        << (result.error.empty() ? "ok" : Escape_(result.error)) << "\"";
+    if (result.error.empty()) {
+      out << ", \"rows\": " << result.rows << ", \"cols\": " << result.cols
+          << ", \"checksum\": " << result.checksum << ", \"values\": [";
+      for (size_t j = 0; j < result.values.size(); ++j)
+        out << (j ? ", " : "") << result.values[j];
+      out << "]";
+    }
+    out << "}";
+  }
+  out << "\n]}\n";
+}
+
+void BatchRunner::WriteCsv(std::ostream &out) const {
+  out << "job,algorithm,mode,inputs,threads,repeat,load_seconds,seconds,"
+         "cached,rows,cols,checksum,status\n"
+      << std::setprecision(17);
+  for (const BatchResult &result : results_)
+    out << result.job << ',' << result.algorithm << ',' << result.mode << ','
+        << '"' << result.inputs << '"' << ',' << result.threads << ','
+        << result.repeat << ',' << result.load_seconds << ','
+        << result.seconds << ',' << result.cached << ',' << result.rows << ','
+        << result.cols << ',' << result.checksum << ',' << '"'
+        << (result.error.empty() ? "ok" : result.error) << '"' << '\n';
+}
+
+std::string BatchRunner::Escape_(const std::string &text) {
+  std::string escaped;
+  for (char symbol : text) {
+    if (symbol == '"' || symbol == '\\') escaped += '\\';
+    if ((unsigned char)symbol < 0x20) continue;
+    escaped += symbol;
+  }
+  return escaped;
+}
+}  // namespace s21
@@ -0,0 +1,101 @@
+#ifndef SRC_BATCH_BATCH_H
+#define SRC_BATCH_BATCH_H
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "../algorithms/AntAlgorithm.h"
+#include "../algorithms/GaussAlgorithm.h"
+#include "../algorithms/WinogradAlgorithm.h"
+#include "../helpers/matrix.h"
+#include "../helpers/matrix_parser.h"
+#include "../helpers/result_cache.h"
+
+namespace s21 {
+
+//  One line of a job file or one --job argument:
+//    winograd FIRST SECOND [mode=classical] [threads=4] [repeat=1]
+//    gauss SYSTEM [mode=parallel] [threads=4] [repeat=1]
+//    ant GRAPH [mode=parallel] [threads=4] [repeat=1]
+//  An input is a matrix file or random:ROWSxCOLS[:SEED]. mode=all runs
+//  every mode of the algorithm as a separate result.
+struct BatchJob {
+  int line = 0;  //  position in the job file, 0 for the command line
+  std::string algorithm;
+  std::vector<std::string> inputs;
+  std::string mode = "all";
+  int threads = 0;  //  0 takes the algorithm's own default
+  int repeat = 1;
+};
+
+struct BatchResult {
+  int job = 0;  //  index into the job list
+  std::string algorithm;
+  std::string mode;
+  std::string inputs;  //  joined by '+'
+  int threads = 1;
+  int repeat = 1;
+  double load_seconds = 0;
+  double seconds = 0;
+  bool cached = false;  //  taken from ResultCache, seconds is the lookup
+  std::string error;    //  empty on success
+  int rows = 0, cols = 0;
+  double checksum = 0;         //  sum of the result matrix or vector
+  std::vector<double> values;  //  solution, tour or matrix if kept
+};
+
+//  Runs jobs back to back in one process, so the allocator arena, the
+//  autotuner profile and the topology are shared by all of them; the
+//  arena is emptied once the last job is done. A job
+//  that fails is reported and the rest still run. Results go through
+//  ResultCache keyed by the operands and the mode (and for ant the repeat
+//  count), so a resubmitted job with identical inputs is answered from the
+//  cache unless it is bypassed.
+class BatchRunner {
+ public:
+  BatchRunner() = default;
+  ~BatchRunner() = default;
+
+  //  false and a message in error if the line can't be parsed
+  static bool ParseJob(const std::string &text, BatchJob &job,
+                       std::string &error);
+  //  Blank lines and lines starting with '#' are skipped
+  bool LoadJobFile(const std::string &path, std::string &error);
+  void AddJob(const BatchJob &job) { jobs_.push_back(job); }
+  const std::vector<BatchJob> &GetJobs() const { return jobs_; }
+
+  //  Result matrices are kept in full only up to this many elements
+  void SetMatrixLimit(long long elements) { matrix_limit_ = elements; }
+  void Run(std::ostream *progress = nullptr);
+  const std::vector<BatchResult> &GetResults() const { return results_; }
+
+  //  "-" writes to standard output
+  bool WriteJson(const std::string &path) const;
+  bool WriteCsv(const std::string &path) const;
+  void WriteJson(std::ostream &out) const;
+  void WriteCsv(std::ostream &out) const;
+
+ private:
+  std::vector<BatchJob> jobs_;
+  std::vector<BatchResult> results_;
+  long long matrix_limit_ = 10000;
+
+  void RunWinograd_(const BatchJob &job, BatchResult base);
+  void RunGauss_(const BatchJob &job, BatchResult base);
+  void RunAnt_(const BatchJob &job, BatchResult base);
+  //  structure, if given, is the one the parser found in a file input
+  //  and stays unknown for random ones. With sparse given a large sparse
+  //  system file is read into it in CSR form and matrix stays empty.
+  static bool LoadInput_(const std::string &algorithm,
+                         const std::string &input, Matrix<double> &matrix,
+                         std::string &error,
+                         MatrixStructure *structure = nullptr,
+                         LinearSystem *sparse = nullptr);
+  static std::vector<std::string> Modes_(const BatchJob &job,
+                                         const std::vector<std::string> &all);
+  static std::string Escape_(const std::string &text);
+};
+}  // namespace s21
+
+#endif  // SRC_BATCH_BATCH_H
@@ -0,0 +1,103 @@
+#include <iostream>
+
+#include "../helpers/topology.h"
+#include "batch.h"
+
+namespace {
+void PrintUsage() {
+  std::cout
+      << "Usage: s21_batch [--jobs FILE]... [--job \"ALGORITHM INPUT... "
+         "[key=value]...\"]...\n"
+         "                 [--json FILE|-] [--csv FILE|-] "
+         "[--matrix-limit N] [--quiet]\n"
+         "                 [--no-cache] [--cache-dir DIR] "
+         "[--affinity none|compact|scatter|cores]\n"
+         "                 [--allocation default|arena|thp|hugetlb|"
+         "first-touch=N,...]\n"
+         "Jobs:\n"
+         "  winograd FIRST SECOND [mode=serial|classical|pipelined|"
+         "autotuned|all]\n"
+         "  gauss SYSTEM [mode=serial|parallel|autotuned|all]\n"
+         "  ant GRAPH [mode=serial|parallel|autotuned|all]\n"
+         "  every job also takes threads=N and repeat=N, an input is a file\n"
+         "  or random:ROWSxCOLS[:SEED]\n"
+         "  --no-cache measures every job, as a benchmark should\n";
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+  s21::BatchRunner runner;
+  std::string json_path = "-", csv_path;
+  bool quiet = false;
+  for (int i = 1; i < argc; ++i) {
+    std::string key = argv[i];
+    if (key == "--quiet" || key == "--no-cache") {
+      if (key == "--quiet") quiet = true;
+      if (key == "--no-cache") s21::ResultCache::SetBypass(true);
+      continue;
+    }
+    if (key == "--help" || i + 1 >= argc) {
+      PrintUsage();
+      return key == "--help" ? 0 : 1;
+    }
+    std::string value = argv[++i], error;
+    if (key == "--jobs") {
+      if (!runner.LoadJobFile(value, error)) {
+        std::cerr << "Error! " << error << std::endl;
+        return 1;
+      }
+    } else if (key == "--job") {
+      s21::BatchJob job;
+      if (!s21::BatchRunner::ParseJob(value, job, error)) {
+        std::cerr << "Error! " << error << std::endl;
+        return 1;
+      }
+      runner.AddJob(job);
+    } else if (key == "--json") {
+      json_path = value;
+    } else if (key == "--csv") {
+      csv_path = value;
+    } else if (key == "--cache-dir") {
+      s21::ResultCache::SetDiskDirectory(value);
+    } else if (key == "--affinity") {
+      s21::AffinityPolicy policy;
+      if (!s21::Topology::ParsePolicy(value, policy)) {
+        std::cerr << "Error! Wrong value for " << key << std::endl;
+        return 1;
+      }
+      s21::Topology::SetPolicy(policy);
+    } else if (key == "--allocation") {
+      s21::AllocationPolicy policy;
+      if (!s21::MatrixAllocator::ParsePolicy(value, policy)) {
+        std::cerr << "Error! Wrong value for " << key << std::endl;
+        return 1;
+      }
+      s21::MatrixAllocator::SetDefaultPolicy(policy);
+    } else if (key == "--matrix-limit") {
+      try {
+        runner.SetMatrixLimit(std::stoll(value));
+      } catch (std::exception &) {
+        std::cerr << "Error! Wrong value for " << key << std::endl;
+        return 1;
+      }
+    } else {
+      PrintUsage();
+      return 1;
+    }
+  }
+  if (runner.GetJobs().empty()) {
+    PrintUsage();
+    return 1;
+  }
+
+  //  Progress goes to stderr, stdout stays machine-readable
+  runner.Run(quiet ? nullptr : &std::cerr);
+  bool written = true;
+  if (!json_path.empty()) written = runner.WriteJson(json_path) && written;
+  if (!csv_path.empty()) written = runner.WriteCsv(csv_path) && written;
+  if (!written) std::cerr << "Error! Can't write the results" << std::endl;
+  int failed = 0;
+  for (const s21::BatchResult &result : runner.GetResults())
+    failed += !result.error.empty();
+  return !written ? 1 : failed > 0 ? 2 : 0;
+}
@@ -0,0 +1,329 @@
+#include "benchmark.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <utility>
+
+namespace s21 {
+Benchmark::Benchmark(BenchmarkOptions options) : options_(std::move(options)) {}
+
+//  Every measured call must compute, whatever it may consult
+void Benchmark::Run() {
+  ResultCache::ScopedBypass bypass;
+  results_.clear();
+  if (options_.perf && !perf_) perf_ = std::make_unique<PerfCounters>();
+  for (int size : options_.sizes) {
+    if (options_.winograd) RunWinograd_(size);
+    if (options_.gauss) RunGauss_(size);
+  }
+  if (options_.ant)
+    for (int size : options_.graph_sizes) RunAnt_(size);
+}
+
+//  2n^3 operations counted for every mode, Winograd's saving shows up as a
+//  higher rate
+void Benchmark::RunWinograd_(int size) {
+  Matrix<double> first = RandomMatrix(size, size, options_.seed);
+  Matrix<double> second = RandomMatrix(size, size, options_.seed + 1);
+  Matrix<double> reference = first * second;
+  double work = 2.0 * size * size * size;
+  WinogradAlgorithm<double> algorithm(first, second);
+  Matrix<double> result;
+
+  auto check = [&](BenchmarkResult &measured) {
+    double error = 0;
+    for (int i = 0; i < size; ++i)
+      for (int j = 0; j < size; ++j)
+        error = std::fmax(error, std::fabs(result(i, j) - reference(i, j)));
+    measured.valid = !algorithm.GetError() && error <= 1e-6;
+    Add_(std::move(measured));
+  };
+  BenchmarkResult measured =
+      Measure_({"winograd", "serial", size, 1}, work, "GFLOP/s", nullptr,
+               [&]() {
+                 result = algorithm.GetResultMatrix(WITHOUT_PARALLELISM);
+               });
+  check(measured);
+  for (int threads : options_.threads) {
+    measured = Measure_({"winograd", "classical", size, threads}, work,
+                        "GFLOP/s", nullptr, [&]() {
+                          result = algorithm.GetResultMatrix(
+                              CLASSICAL_PARALLELISM, threads);
+                        });
+    check(measured);
+  }
+  //  The pipeline always runs its three stages on three threads
+  measured = Measure_(
+      {"winograd", "pipelined", size, 3}, work, "GFLOP/s", nullptr,
+      [&]() { result = algorithm.GetResultMatrix(PIPELINED_PARALLELISM); });
+  check(measured);
+}
+
+void Benchmark::RunGauss_(int size) {
+  Matrix<double> system = RandomSystem(size, options_.seed);
+  Matrix<double> work_matrix;
+  std::vector<double> solution;
+  double work = 2.0 / 3.0 * size * size * size;
+  auto prepare = [&]() { work_matrix = system; };
+
+  auto check = [&](BenchmarkResult &measured) {
+    double residual = (int)solution.size() == size ? 0 : INFINITY;
+    for (int i = 0; i < size && (int)solution.size() == size; ++i) {
+      double sum = system(i, size);
+      for (int j = 0; j < size; ++j) sum -= system(i, j) * solution[j];
+      residual = std::fmax(residual, std::fabs(sum));
+    }
+    measured.valid = residual <= 1e-6;
+    Add_(std::move(measured));
+  };
+  BenchmarkResult measured =
+      Measure_({"gauss", "serial", size, 1}, work, "GFLOP/s", prepare, [&]() {
+        solution = GaussAlgorithm::GaussWithoutParallelism(work_matrix);
+      });
+  check(measured);
+  for (int threads : options_.threads) {
+    measured = Measure_({"gauss", "parallel", size, threads}, work, "GFLOP/s",
+                        prepare, [&]() {
+                          solution = GaussAlgorithm::GaussWithParallelism(
+                              work_matrix, threads);
+                        });
+    check(measured);
+  }
+}
+
+//  Serial ACO runs 1000 iterations, the parallel mode four threads of 250,
+//  in both cases every iteration sends out one ant per vertex
+void Benchmark::RunAnt_(int size) {
+  Matrix<double> graph = RandomGraph(size, options_.seed);
+  double work = 1000.0 * size;
+  TsmResult result;
+  for (int parallel = 0; parallel < 2; ++parallel) {
+    BenchmarkResult measured = Measure_(
+        {"ant", parallel ? "parallel" : "serial", size, parallel ? 4 : 1},
+        work, "tours/s", nullptr,
+        [&]() { result = AntAlgorithm(graph, 1).GetResult(parallel); });
+    measured.valid =
+        result.distance < INT_MAX && (int)result.vertices.size() >= size;
+    Add_(std::move(measured));
+  }
+}
+
+BenchmarkResult Benchmark::Measure(const BenchmarkCase &config, double work,
+                                   const std::string &unit, int warmup,
+                                   int repetitions,
+                                   const std::function<void()> &prepare,
+                                   const std::function<void()> &run,
+                                   PerfCounters *perf) {
+  BenchmarkResult result;
+  result.config = config;
+  result.work = work;
+  result.unit = unit;
+  result.has_perf = perf != nullptr && perf->IsAvailable();
+  for (int i = 0; i < warmup + repetitions; ++i) {
+    if (prepare) prepare();
+    if (result.has_perf) perf->Start();
+    auto start_time = Clock::now();
+    run();
+    std::chrono::duration<double> duration = Clock::now() - start_time;
+    PerfSample sample = result.has_perf ? perf->Stop() : PerfSample();
+    if (i < warmup) continue;
+    result.times.push_back(duration.count());
+    if (i == warmup)
+      result.perf = sample;
+    else
+      result.perf.Add(sample);
+  }
+  CalculateStatistics(result);
+  return result;
+}
+
+BenchmarkResult Benchmark::Measure_(const BenchmarkCase &config, double work,
+                                    const std::string &unit,
+                                    const std::function<void()> &prepare,
+                                    const std::function<void()> &run) {
+  return Measure(config, work, unit, options_.warmup, options_.repetitions,
+                 prepare, run, perf_.get());
+}
+
+//  p95 is the nearest-rank percentile, variance the sample variance
+void Benchmark::CalculateStatistics(BenchmarkResult &result) {
+  std::vector<double> sorted = result.times;
+  int count = (int)sorted.size();
+  if (count == 0) return;
+  std::sort(sorted.begin(), sorted.end());
+  result.min = sorted.front();
+  result.max = sorted.back();
+  result.median = count % 2 ? sorted[count / 2]
+                            : (sorted[count / 2 - 1] + sorted[count / 2]) / 2;
+  int rank = (int)std::ceil(0.95 * count);
+  result.p95 = sorted[rank > 0 ? rank - 1 : 0];
+  double sum = 0;
+  for (double time : sorted) sum += time;
+  result.mean = sum / count;
+  double squares = 0;
+  for (double time : sorted)
+    squares += (time - result.mean) * (time - result.mean);
+  result.variance = count > 1 ? squares / (count - 1) : 0;
+  double scale = result.unit == "GFLOP/s" ? 1e9 : 1;
+  result.rate = result.median > 0 ? result.work / result.median / scale : 0;
+}
+
+void Benchmark::Add_(BenchmarkResult result) {
+  results_.push_back(std::move(result));
+}
+
+Matrix<double> Benchmark::RandomMatrix(int rows, int cols, unsigned seed) {
+  std::mt19937 engine(seed);
+  std::uniform_int_distribution<int> dist(-100, 100);
+  Matrix<double> matrix(rows, cols);
+  for (int i = 0; i < rows; ++i) {
+    double *row = matrix.GetRow(i);
+    for (int j = 0; j < cols; ++j) row[j] = dist(engine);
+  }
+  return matrix;
+}
+
+//  Dense and diagonally dominant, so neither the banded nor the sparse
+//  shortcut of GaussAlgorithm applies and no pivoting is needed
+Matrix<double> Benchmark::RandomSystem(int size, unsigned seed) {
+  Matrix<double> matrix = RandomMatrix(size, size + 1, seed);
+  for (int i = 0; i < size; ++i) {
+    double sum = 0;
+    for (int j = 0; j < size; ++j) sum += std::fabs(matrix(i, j));
+    matrix(i, i) = sum + 1;
+  }
+  return matrix;
+}
+
+Matrix<double> Benchmark::RandomGraph(int size, unsigned seed) {
+  std::mt19937 engine(seed);
+  std::uniform_int_distribution<int> dist(1, 100);
+  Matrix<double> graph(size, size);
+  for (int i = 0; i < size; ++i)
+    for (int j = i + 1; j < size; ++j) graph(i, j) = graph(j, i) = dist(engine);
+  return graph;
+}
+
+void Benchmark::PrintTable(std::ostream &out) const {
+  out << std::left << std::setw(10) << "algorithm" << std::setw(11) << "mode"
+      << std::right << std::setw(6) << "size" << std::setw(8) << "threads"
+      << std::setw(13) << "median s" << std::setw(13) << "p95 s"
+      << std::setw(12) << "cv %" << std::setw(14) << "rate"
+      << "  unit\n";
+  for (const BenchmarkResult &result : results_) {
+    double cv = result.mean > 0 ? std::sqrt(result.variance) / result.mean : 0;
+    out << std::left << std::setw(10) << result.config.algorithm
+        << std::setw(11) << result.config.mode << std::right << std::setw(6)
+        << result.config.size << std::setw(8) << result.config.threads
+        << std::setw(13) << std::setprecision(6) << result.median
+        << std::setw(13) << result.p95 << std::setw(12)
+        << std::setprecision(3) << cv * 100 << std::setw(14)
+        << std::setprecision(6) << result.rate << "  " << result.unit
+        << (result.valid ? "" : "  WRONG RESULT") << "\n";
+  }
+  if (perf_ && !perf_->IsAvailable())
+    out << "\nHardware counters unavailable: " << perf_->GetError() << "\n";
+  else if (perf_)
+    PrintPerfTable_(out);
+}
+
+//  Counter columns the kernel refused print as n/a. MPKI is misses per
+//  thousand instructions, GB/s the memory traffic implied by LLC misses.
+void Benchmark::PrintPerfTable_(std::ostream &out) const {
+  auto cell = [&out](double value, int width) {
+    if (value < 0)
+      out << std::setw(width) << "n/a";
+    else
+      out << std::setw(width) << std::setprecision(3) << value;
+  };
+  out << "\n" << std::left << std::setw(10) << "algorithm" << std::setw(11)
+      << "mode" << std::right << std::setw(6) << "size" << std::setw(8)
+      << "threads" << std::setw(8) << "IPC" << std::setw(12) << "LLC miss %"
+      << std::setw(12) << "dTLB MPKI" << std::setw(12) << "branch MPKI"
+      << std::setw(10) << "GB/s\n";
+  for (const BenchmarkResult &result : results_) {
+    double seconds = 0;
+    for (double time : result.times) seconds += time;
+    double miss_rate = result.perf.LlcMissRate();
+    out << std::left << std::setw(10) << result.config.algorithm
+        << std::setw(11) << result.config.mode << std::right << std::setw(6)
+        << result.config.size << std::setw(8) << result.config.threads;
+    cell(result.perf.Ipc(), 8);
+    cell(miss_rate < 0 ? miss_rate : miss_rate * 100, 12);
+    cell(result.perf.PerKiloInstructions(PERF_DTLB_MISSES), 12);
+    cell(result.perf.PerKiloInstructions(PERF_BRANCH_MISSES), 12);
+    cell(result.perf.Bandwidth(seconds), 9);
+    out << "\n";
+  }
+}
+
+bool Benchmark::WriteCsv(const std::string &path) const {
+  std::ofstream file(path);
+  if (!file.is_open()) return false;
+  file << "label,algorithm,mode,size,threads,repetitions,median,p95,mean,"
+          "variance,min,max,rate,unit,valid";
+  for (int i = 0; i < PERF_EVENT_COUNT; ++i)
+    file << ',' << PerfCounters::GetEventName((PerfEvent)i);
+  file << '\n' << std::setprecision(9);
+  for (const BenchmarkResult &result : results_) {
+    file << options_.label << ',' << result.config.algorithm << ','
+         << result.config.mode << ',' << result.config.size << ','
+         << result.config.threads << ',' << result.times.size() << ','
+         << result.median << ',' << result.p95 << ',' << result.mean << ','
+         << result.variance << ',' << result.min << ',' << result.max << ','
+         << result.rate << ',' << result.unit << ','
+         << (result.valid ? 1 : 0);
+    for (int i = 0; i < PERF_EVENT_COUNT; ++i)
+      file << ',' << result.perf.values[i];
+    file << '\n';
+  }
+  return (bool)file;
+}
+
+bool Benchmark::WriteJson(const std::string &path) const {
+  std::ofstream file(path);
+  if (!file.is_open()) return false;
+  const Topology &topology = Topology::Get();
+  file << std::setprecision(9) << "{\n  \"label\": \"" << options_.label
+       << "\",\n  \"timestamp\": " << (long long)std::time(nullptr)
+       << ",\n  \"seed\": " << options_.seed
+       << ",\n  \"warmup\": " << options_.warmup
+       << ",\n  \"cpus\": " << topology.GetCpuCount()
+       << ",\n  \"cores\": " << topology.GetCoreCount()
+       << ",\n  \"affinity\": \""
+       << Topology::GetPolicyName(Topology::GetPolicy())
+       << "\",\n  \"results\": [";
+  for (size_t i = 0; i < results_.size(); ++i) {
+    const BenchmarkResult &result = results_[i];
+    file << (i ? ",\n" : "\n") << "    {\"algorithm\": \""
+         << result.config.algorithm << "\", \"mode\": \""
+         << result.config.mode << "\", \"size\": " << result.config.size
+         << ", \"threads\": " << result.config.threads
+         << ", \"median\": " << result.median << ", \"p95\": " << result.p95
+         << ", \"mean\": " << result.mean
+         << ", \"variance\": " << result.variance << ", \"min\": " << result.min
+         << ", \"max\": " << result.max << ", \"rate\": " << result.rate
+         << ", \"unit\": \"" << result.unit
+         << "\", \"valid\": " << (result.valid ? "true" : "false")
+         << ", \"times\": [";
+    for (size_t j = 0; j < result.times.size(); ++j)
+      file << (j ? ", " : "") << result.times[j];
+    file << "]";
+    if (result.has_perf) {
+      file << ", \"counters\": {";
+      for (int j = 0; j < PERF_EVENT_COUNT; ++j)
+        file << (j ? ", \"" : "\"") << PerfCounters::GetEventName((PerfEvent)j)
+             << "\": " << result.perf.values[j];
+      file << "}";
+    }
+    file << "}";
+  }
+  file << "\n  ]\n}\n";
+  return (bool)file;
+}
+}  // namespace s21
@@ -0,0 +1,101 @@
+#ifndef SRC_BENCHMARK_BENCHMARK_H
+#define SRC_BENCHMARK_BENCHMARK_H
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "../algorithms/AntAlgorithm.h"
+#include "../algorithms/GaussAlgorithm.h"
+#include "../algorithms/WinogradAlgorithm.h"
+#include "../helpers/matrix.h"
+#include "../helpers/result_cache.h"
+#include "../helpers/trace.h"
+#include "perf_counters.h"
+
+namespace s21 {
+
+struct BenchmarkOptions {
+  std::vector<int> sizes{64, 128, 256};
+  std::vector<int> threads{1, 2, 4};
+  std::vector<int> graph_sizes{10, 20};  //  ACO works on much smaller inputs
+  bool winograd = true, gauss = true, ant = true;
+  int warmup = 1;
+  int repetitions = 5;
+  unsigned seed = 42;
+  std::string label;  //  e.g. the version under test, copied to the output
+  std::string csv_path = "bench.csv";
+  std::string json_path = "bench.json";
+  std::string trace_path;  //  Chrome trace JSON, empty disables
+  bool perf = false;       //  hardware counters around every repetition
+};
+
+struct BenchmarkCase {
+  std::string algorithm;
+  std::string mode;
+  int size = 0;
+  int threads = 1;
+};
+
+struct BenchmarkResult {
+  BenchmarkCase config;
+  std::vector<double> times;  //  seconds, one per measured repetition
+  double median = 0, p95 = 0, mean = 0, variance = 0, min = 0, max = 0;
+  double work = 0;  //  floating point operations or tours per repetition
+  double rate = 0;  //  work / median in GFLOP/s or tours/s
+  std::string unit;
+  bool valid = true;  //  the result of the last repetition was checked
+  bool has_perf = false;
+  PerfSample perf;  //  summed over the measured repetitions
+};
+
+//  Sweeps every enabled algorithm over sizes, thread counts and execution
+//  modes. Inputs come from a seeded generator, so two runs with the same
+//  options measure exactly the same work.
+class Benchmark {
+ public:
+  explicit Benchmark(BenchmarkOptions options);
+  ~Benchmark() = default;
+
+  void Run();
+  const std::vector<BenchmarkResult> &GetResults() const { return results_; }
+  void PrintTable(std::ostream &out) const;
+  bool WriteCsv(const std::string &path) const;
+  bool WriteJson(const std::string &path) const;
+
+  //  prepare runs before every repetition and is neither timed nor counted
+  static BenchmarkResult Measure(const BenchmarkCase &config, double work,
+                                 const std::string &unit, int warmup,
+                                 int repetitions,
+                                 const std::function<void()> &prepare,
+                                 const std::function<void()> &run,
+                                 PerfCounters *perf = nullptr);
+  static void CalculateStatistics(BenchmarkResult &result);
+
+  static Matrix<double> RandomMatrix(int rows, int cols, unsigned seed);
+  static Matrix<double> RandomSystem(int size, unsigned seed);
+  static Matrix<double> RandomGraph(int size, unsigned seed);
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  BenchmarkOptions options_;
+  std::vector<BenchmarkResult> results_;
+  std::unique_ptr<PerfCounters> perf_;
+
+  void RunWinograd_(int size);
+  void RunGauss_(int size);
+  void RunAnt_(int size);
+  void Add_(BenchmarkResult result);
+  BenchmarkResult Measure_(const BenchmarkCase &config, double work,
+                           const std::string &unit,
+                           const std::function<void()> &prepare,
+                           const std::function<void()> &run);
+  void PrintPerfTable_(std::ostream &out) const;
+};
+}  // namespace s21
+
+#endif  // SRC_BENCHMARK_BENCHMARK_H
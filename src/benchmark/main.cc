@@ -0,0 +1,105 @@
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#include "../helpers/topology.h"
+#include "benchmark.h"
+
+namespace {
+std::vector<int> ParseList(const std::string &text) {
+  std::vector<int> values;
+  std::istringstream stream(text);
+  std::string item;
+  while (std::getline(stream, item, ','))
+    if (!item.empty()) values.push_back(std::stoi(item));
+  return values;
+}
+
+void PrintUsage() {
+  std::cout << "Usage: bench [--sizes 64,128] [--threads 1,2,4] "
+               "[--graphs 10,20]\n"
+               "             [--algorithms winograd,gauss,ant] [--warmup N] "
+               "[--reps N]\n"
+               "             [--seed N] [--label TEXT] [--csv FILE] "
+               "[--json FILE]\n"
+               "             [--affinity none|compact|scatter|cores]\n"
+               "             [--trace FILE]  (needs a build with S21_TRACE)\n"
+               "             [--perf]  hardware counters per case\n";
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+  s21::BenchmarkOptions options;
+  for (int i = 1; i < argc; ++i) {
+    std::string key = argv[i];
+    if (key == "--perf") {
+      options.perf = true;
+      continue;
+    }
+    if (key == "--help" || i + 1 >= argc) {
+      PrintUsage();
+      return key == "--help" ? 0 : 1;
+    }
+    std::string value = argv[++i];
+    try {
+      if (key == "--sizes") {
+        options.sizes = ParseList(value);
+      } else if (key == "--threads") {
+        options.threads = ParseList(value);
+      } else if (key == "--graphs") {
+        options.graph_sizes = ParseList(value);
+      } else if (key == "--algorithms") {
+        options.winograd = value.find("winograd") != std::string::npos;
+        options.gauss = value.find("gauss") != std::string::npos;
+        options.ant = value.find("ant") != std::string::npos;
+      } else if (key == "--warmup") {
+        options.warmup = std::stoi(value);
+      } else if (key == "--reps") {
+        options.repetitions = std::stoi(value);
+      } else if (key == "--seed") {
+        options.seed = (unsigned)std::stoul(value);
+      } else if (key == "--label") {
+        options.label = value;
+      } else if (key == "--csv") {
+        options.csv_path = value;
+      } else if (key == "--json") {
+        options.json_path = value;
+      } else if (key == "--trace") {
+        options.trace_path = value;
+      } else if (key == "--affinity") {
+        s21::AffinityPolicy policy;
+        if (!s21::Topology::ParsePolicy(value, policy))
+          throw std::invalid_argument(key);
+        s21::Topology::SetPolicy(policy);
+      } else {
+        PrintUsage();
+        return 1;
+      }
+    } catch (std::exception &) {
+      std::cout << "Error! Wrong value for " << key << std::endl;
+      return 1;
+    }
+  }
+  if (options.repetitions < 1) options.repetitions = 1;
+
+  s21::Benchmark benchmark(options);
+  benchmark.Run();
+  benchmark.PrintTable(std::cout);
+  if (!options.csv_path.empty() && !benchmark.WriteCsv(options.csv_path))
+    std::cout << "Error! Can't write " << options.csv_path << std::endl;
+  if (!options.json_path.empty() && !benchmark.WriteJson(options.json_path))
+    std::cout << "Error! Can't write " << options.json_path << std::endl;
+  if (!options.trace_path.empty()) {
+#ifdef S21_TRACE
+    if (!s21::Trace::WriteChromeJson(options.trace_path))
+      std::cout << "Error! Can't write " << options.trace_path << std::endl;
+    else if (s21::Trace::GetDropped() > 0)
+      std::cout << s21::Trace::GetDropped()
+                << " oldest trace events were overwritten" << std::endl;
+#else
+    std::cout << "Tracing is off, rebuild with make bench TRACE=1"
+              << std::endl;
+#endif
+  }
+  return 0;
+}
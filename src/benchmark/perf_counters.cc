@@ -0,0 +1,164 @@
+#include "perf_counters.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+
+namespace s21 {
+void PerfSample::Add(const PerfSample &other) {
+  for (int i = 0; i < PERF_EVENT_COUNT; ++i)
+    values[i] = values[i] < 0 || other.values[i] < 0
+                    ? -1
+                    : values[i] + other.values[i];
+}
+
+double PerfSample::Ipc() const {
+  if (!Has(PERF_CYCLES) || !Has(PERF_INSTRUCTIONS) || values[PERF_CYCLES] == 0)
+    return -1;
+  return (double)values[PERF_INSTRUCTIONS] / values[PERF_CYCLES];
+}
+
+double PerfSample::LlcMissRate() const {
+  if (!Has(PERF_LLC_MISSES) || !Has(PERF_LLC_REFERENCES) ||
+      values[PERF_LLC_REFERENCES] == 0)
+    return -1;
+  return (double)values[PERF_LLC_MISSES] / values[PERF_LLC_REFERENCES];
+}
+
+double PerfSample::PerKiloInstructions(PerfEvent event) const {
+  if (!Has(event) || !Has(PERF_INSTRUCTIONS) ||
+      values[PERF_INSTRUCTIONS] == 0)
+    return -1;
+  return 1000.0 * values[event] / values[PERF_INSTRUCTIONS];
+}
+
+//  Every LLC miss brings one line in from memory, write-backs are not
+//  counted, so this is a lower bound of the real traffic
+double PerfSample::Bandwidth(double seconds) const {
+  if (!Has(PERF_LLC_MISSES) || seconds <= 0) return -1;
+  return (double)values[PERF_LLC_MISSES] * PerfCounters::kCacheLine /
+         seconds / 1e9;
+}
+
+const char *PerfCounters::GetEventName(PerfEvent event) {
+  switch (event) {
+    case PERF_CYCLES:
+      return "cycles";
+    case PERF_INSTRUCTIONS:
+      return "instructions";
+    case PERF_LLC_REFERENCES:
+      return "llc_references";
+    case PERF_LLC_MISSES:
+      return "llc_misses";
+    case PERF_DTLB_MISSES:
+      return "dtlb_misses";
+    case PERF_BRANCH_MISSES:
+      return "branch_misses";
+    default:
+      return "unknown";
+  }
+}
+
+#ifdef __linux__
+namespace {
+int OpenEvent(PerfEvent event) {
+  perf_event_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = PERF_TYPE_HARDWARE;
+  switch (event) {
+    case PERF_CYCLES:
+      attr.config = PERF_COUNT_HW_CPU_CYCLES;
+      break;
+    case PERF_INSTRUCTIONS:
+      attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+      break;
+    case PERF_LLC_REFERENCES:
+      attr.config = PERF_COUNT_HW_CACHE_REFERENCES;
+      break;
+    case PERF_LLC_MISSES:
+      attr.config = PERF_COUNT_HW_CACHE_MISSES;
+      break;
+    case PERF_DTLB_MISSES:
+      attr.type = PERF_TYPE_HW_CACHE;
+      attr.config = PERF_COUNT_HW_CACHE_DTLB |
+                    (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                    (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+      break;
+    default:
+      attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+  }
+  attr.disabled = 1;
+  attr.inherit = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format =
+      PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+}  // namespace
+
+PerfCounters::PerfCounters() : descriptors_(PERF_EVENT_COUNT, -1) {
+  for (int i = 0; i < PERF_EVENT_COUNT; ++i) {
+    descriptors_[i] = OpenEvent((PerfEvent)i);
+    if (descriptors_[i] < 0 && error_.empty())
+      error_ = std::string(GetEventName((PerfEvent)i)) + ": " +
+               std::strerror(errno) +
+               " (see /proc/sys/kernel/perf_event_paranoid)";
+  }
+}
+
+PerfCounters::~PerfCounters() {
+  for (int descriptor : descriptors_)
+    if (descriptor >= 0) close(descriptor);
+}
+
+void PerfCounters::Start() {
+  for (int descriptor : descriptors_) {
+    if (descriptor < 0) continue;
+    ioctl(descriptor, PERF_EVENT_IOC_RESET, 0);
+    ioctl(descriptor, PERF_EVENT_IOC_ENABLE, 0);
+  }
+}
+
+//  With more events than hardware counters the kernel time-slices them,
+//  value * enabled / running estimates the full count
+PerfSample PerfCounters::Stop() {
+  PerfSample sample;
+  for (int descriptor : descriptors_)
+    if (descriptor >= 0) ioctl(descriptor, PERF_EVENT_IOC_DISABLE, 0);
+  for (int i = 0; i < PERF_EVENT_COUNT; ++i) {
+    uint64_t data[3] = {0, 0, 0};
+    if (descriptors_[i] < 0 ||
+        read(descriptors_[i], data, sizeof(data)) != (ssize_t)sizeof(data))
+      continue;
+    sample.values[i] =
+        data[2] == 0 ? 0 : (long long)((double)data[0] * data[1] / data[2]);
+  }
+  return sample;
+}
+#else
+PerfCounters::PerfCounters()
+    : descriptors_(PERF_EVENT_COUNT, -1),
+      error_("hardware counters need Linux perf_event_open") {}
+
+PerfCounters::~PerfCounters() = default;
+
+void PerfCounters::Start() {}
+
+PerfSample PerfCounters::Stop() { return PerfSample(); }
+#endif
+
+bool PerfCounters::IsAvailable() const {
+  for (int descriptor : descriptors_)
+    if (descriptor >= 0) return true;
+  return false;
+}
+}  // namespace s21
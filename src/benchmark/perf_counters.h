@@ -0,0 +1,58 @@
+#ifndef SRC_BENCHMARK_PERF_COUNTERS_H
+#define SRC_BENCHMARK_PERF_COUNTERS_H
+
+#include <string>
+#include <vector>
+
+namespace s21 {
+
+enum PerfEvent {
+  PERF_CYCLES,
+  PERF_INSTRUCTIONS,
+  PERF_LLC_REFERENCES,
+  PERF_LLC_MISSES,
+  PERF_DTLB_MISSES,
+  PERF_BRANCH_MISSES,
+  PERF_EVENT_COUNT
+};
+
+//  Raw counts of one measurement, -1 where the counter could not be opened
+struct PerfSample {
+  long long values[PERF_EVENT_COUNT] = {-1, -1, -1, -1, -1, -1};
+
+  [[nodiscard]] bool Has(PerfEvent event) const { return values[event] >= 0; }
+  void Add(const PerfSample &other);
+  [[nodiscard]] double Ipc() const;
+  [[nodiscard]] double LlcMissRate() const;          //  misses / references
+  [[nodiscard]] double PerKiloInstructions(PerfEvent event) const;
+  [[nodiscard]] double Bandwidth(double seconds) const;  //  GB/s from LLC
+};
+
+//  User-space hardware counters of the calling process and every thread it
+//  starts while they are open (inherit), so the worker threads of the
+//  algorithms are counted too. Counters the kernel refuses, e.g. with
+//  perf_event_paranoid > 2 or inside a VM, stay -1 instead of failing.
+class PerfCounters {
+ public:
+  static constexpr int kCacheLine = 64;
+
+  PerfCounters();
+  ~PerfCounters();
+  PerfCounters(const PerfCounters &) = delete;
+  PerfCounters &operator=(const PerfCounters &) = delete;
+
+  [[nodiscard]] bool IsAvailable() const;
+  [[nodiscard]] const std::string &GetError() const { return error_; }
+
+  void Start();
+  PerfSample Stop();  //  counts since Start, scaled if multiplexed
+
+  static const char *GetEventName(PerfEvent event);
+
+ private:
+  std::vector<int> descriptors_;
+  std::string error_;
+};
+}  // namespace s21
+
+#endif  // SRC_BENCHMARK_PERF_COUNTERS_H
@@ -0,0 +1,199 @@
+#include "scaling.h"
+
+#include <climits>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <utility>
+
+namespace s21 {
+ScalingReport::ScalingReport(ScalingOptions options)
+    : options_(std::move(options)) {}
+
+std::vector<int> ScalingReport::GetThreadCounts() const {
+  int max_threads = options_.max_threads > 0
+                        ? options_.max_threads
+                        : Topology::Get().GetMaxThreads();
+  std::vector<int> counts;
+  for (int threads = 1; threads < max_threads; threads *= 2)
+    counts.push_back(threads);
+  counts.push_back(max_threads);
+  return counts;
+}
+
+int ScalingReport::WeakSize(int size, int threads) {
+  return (int)std::lround(size * std::cbrt((double)threads));
+}
+
+//  Karp-Flatt turns a measured speedup S on p threads back into Amdahl's
+//  serial fraction, (1/S - 1/p) / (1 - 1/p). Under weak scaling the
+//  matching model is Gustafson's, S = p - f(p - 1).
+void ScalingReport::Evaluate(ScalingPoint &point) {
+  int p = point.threads;
+  point.speedup = point.time > 0 ? point.serial_time / point.time : 0;
+  point.efficiency = point.speedup / p;
+  point.slower = point.time > point.serial_time;
+  if (p < 2 || point.speedup <= 0)
+    point.serial_fraction = 0;
+  else if (point.kind == "weak")
+    point.serial_fraction = (p - point.speedup) / (p - 1);
+  else
+    point.serial_fraction = (1 / point.speedup - 1.0 / p) / (1 - 1.0 / p);
+}
+
+void ScalingReport::Run() {
+  ResultCache::ScopedBypass bypass;
+  points_.clear();
+  serial_times_.clear();
+  if (options_.winograd) RunWinograd_();
+  if (options_.gauss) RunGauss_();
+  if (options_.ant) RunAnt_();
+}
+
+void ScalingReport::RunWinograd_() {
+  Matrix<double> result, reference;
+  std::unique_ptr<WinogradAlgorithm<double>> algorithm;
+  Workload workload;
+  workload.setup = [&](int size) {
+    Matrix<double> first = Benchmark::RandomMatrix(size, size, options_.seed);
+    Matrix<double> second =
+        Benchmark::RandomMatrix(size, size, options_.seed + 1);
+    reference = first * second;
+    algorithm = std::make_unique<WinogradAlgorithm<double>>(first, second);
+  };
+  workload.check = [&]() {
+    for (int i = 0; i < reference.GetRows(); ++i)
+      for (int j = 0; j < reference.GetCols(); ++j)
+        if (std::fabs(result(i, j) - reference(i, j)) > 1e-6) return false;
+    return !algorithm->GetError();
+  };
+  workload.run = [&](int threads) {
+    result = algorithm->GetResultMatrix(
+        threads == 0 ? WITHOUT_PARALLELISM : CLASSICAL_PARALLELISM, threads);
+  };
+  Sweep_("winograd", "classical", options_.matrix_size, GetThreadCounts(),
+         workload);
+  //  The pipeline has exactly three stages, so it has a single point
+  workload.run = [&](int threads) {
+    result = algorithm->GetResultMatrix(
+        threads == 0 ? WITHOUT_PARALLELISM : PIPELINED_PARALLELISM);
+  };
+  Sweep_("winograd", "pipelined", options_.matrix_size, {3}, workload);
+}
+
+void ScalingReport::RunGauss_() {
+  Matrix<double> system, work_matrix;
+  std::vector<double> solution;
+  Workload workload;
+  workload.setup = [&](int size) {
+    system = Benchmark::RandomSystem(size, options_.seed);
+  };
+  workload.prepare = [&]() { work_matrix = system; };
+  workload.run = [&](int threads) {
+    solution = threads == 0
+                   ? GaussAlgorithm::GaussWithoutParallelism(work_matrix)
+                   : GaussAlgorithm::GaussWithParallelism(work_matrix, threads);
+  };
+  workload.check = [&]() {
+    int size = system.GetRows();
+    if ((int)solution.size() != size) return false;
+    for (int i = 0; i < size; ++i) {
+      double sum = system(i, size);
+      for (int j = 0; j < size; ++j) sum -= system(i, j) * solution[j];
+      if (std::fabs(sum) > 1e-6) return false;
+    }
+    return true;
+  };
+  Sweep_("gauss", "parallel", options_.gauss_size, GetThreadCounts(),
+         workload);
+}
+
+void ScalingReport::RunAnt_() {
+  Matrix<double> graph;
+  TsmResult result;
+  Workload workload;
+  workload.setup = [&](int size) {
+    graph = Benchmark::RandomGraph(size, options_.seed);
+  };
+  workload.run = [&](int threads) {
+    AntAlgorithm algorithm(graph, 1);
+    result = threads == 0 ? algorithm.GetResult(false)
+                          : algorithm.GetResultWithParallelism(threads);
+  };
+  workload.check = [&]() {
+    return result.distance < INT_MAX &&
+           (int)result.vertices.size() >= graph.GetRows();
+  };
+  Sweep_("ant", "parallel", options_.graph_size, GetThreadCounts(), workload);
+}
+
+void ScalingReport::Sweep_(const std::string &algorithm,
+                           const std::string &mode, int base_size,
+                           const std::vector<int> &threads,
+                           const Workload &workload) {
+  for (int weak = 0; weak < 2; ++weak) {
+    if ((weak && !options_.weak) || (!weak && !options_.strong)) continue;
+    for (int count : threads) {
+      ScalingPoint point;
+      point.algorithm = algorithm;
+      point.mode = mode;
+      point.kind = weak ? "weak" : "strong";
+      point.threads = count;
+      point.size = weak ? WeakSize(base_size, count) : base_size;
+      workload.setup(point.size);
+      auto key = std::make_pair(algorithm, point.size);
+      if (serial_times_.count(key) == 0)
+        serial_times_[key] = Time_(workload, 0, point.valid);
+      point.serial_time = serial_times_[key];
+      point.time = Time_(workload, count, point.valid);
+      Evaluate(point);
+      points_.push_back(point);
+    }
+  }
+}
+
+double ScalingReport::Time_(const Workload &workload, int threads,
+                            bool &valid) const {
+  BenchmarkResult result = Benchmark::Measure(
+      {}, 0, "s", options_.warmup, options_.repetitions, workload.prepare,
+      [&]() { workload.run(threads); });
+  valid = valid && workload.check();
+  return result.median;
+}
+
+void ScalingReport::Print(std::ostream &out) const {
+  out << std::left << std::setw(10) << "algorithm" << std::setw(11) << "mode"
+      << std::setw(8) << "scaling" << std::right << std::setw(8) << "threads"
+      << std::setw(6) << "size" << std::setw(13) << "serial s"
+      << std::setw(13) << "parallel s" << std::setw(9) << "speedup"
+      << std::setw(12) << "efficiency" << std::setw(10) << "serial f"
+      << "\n";
+  for (const ScalingPoint &point : points_) {
+    out << std::left << std::setw(10) << point.algorithm << std::setw(11)
+        << point.mode << std::setw(8) << point.kind << std::right
+        << std::setw(8) << point.threads << std::setw(6) << point.size
+        << std::setprecision(6) << std::setw(13) << point.serial_time
+        << std::setw(13) << point.time << std::setprecision(3)
+        << std::setw(9) << point.speedup << std::setw(12) << point.efficiency
+        << std::setw(10) << point.serial_fraction
+        << (point.slower ? "  SLOWER THAN SERIAL" : "")
+        << (point.valid ? "" : "  WRONG RESULT") << "\n";
+  }
+}
+
+bool ScalingReport::WriteCsv(const std::string &path) const {
+  std::ofstream file(path);
+  if (!file.is_open()) return false;
+  file << "algorithm,mode,scaling,threads,size,serial_time,time,speedup,"
+          "efficiency,serial_fraction,slower,valid\n"
+       << std::setprecision(9);
+  for (const ScalingPoint &point : points_)
+    file << point.algorithm << ',' << point.mode << ',' << point.kind << ','
+         << point.threads << ',' << point.size << ',' << point.serial_time
+         << ',' << point.time << ',' << point.speedup << ','
+         << point.efficiency << ',' << point.serial_fraction << ','
+         << (point.slower ? 1 : 0) << ',' << (point.valid ? 1 : 0) << '\n';
+  return (bool)file;
+}
+}  // namespace s21
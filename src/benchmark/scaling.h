@@ -0,0 +1,85 @@
+#ifndef SRC_BENCHMARK_SCALING_H
+#define SRC_BENCHMARK_SCALING_H
+
+#include <functional>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+
+namespace s21 {
+
+struct ScalingOptions {
+  int max_threads = 0;  //  0 takes Topology::GetMaxThreads()
+  int matrix_size = 256;
+  int gauss_size = 256;
+  int graph_size = 20;
+  bool strong = true, weak = true;
+  bool winograd = true, gauss = true, ant = true;
+  int warmup = 1;
+  int repetitions = 3;
+  unsigned seed = 42;
+  std::string csv_path = "scaling.csv";
+};
+
+struct ScalingPoint {
+  std::string algorithm;
+  std::string mode;
+  std::string kind;  //  "strong" or "weak"
+  int threads = 1;
+  int size = 0;
+  double serial_time = 0;  //  serial implementation, same size
+  double time = 0;         //  parallel implementation, median
+  double speedup = 0;
+  double efficiency = 0;
+  double serial_fraction = 0;  //  Karp-Flatt (strong), Gustafson (weak)
+  bool slower = false;         //  parallel lost to serial
+  bool valid = true;
+};
+
+//  Strong scaling keeps the size fixed, weak scaling grows it with the
+//  thread count so every thread keeps the work of the one thread run. All
+//  three algorithms do O(n^3) work, so the size grows with cbrt(threads).
+//  Thread counts are 1, 2, 4, ... and max_threads itself.
+class ScalingReport {
+ public:
+  explicit ScalingReport(ScalingOptions options);
+  ~ScalingReport() = default;
+
+  void Run();
+  const std::vector<ScalingPoint> &GetPoints() const { return points_; }
+  void Print(std::ostream &out) const;
+  bool WriteCsv(const std::string &path) const;
+
+  std::vector<int> GetThreadCounts() const;
+  static int WeakSize(int size, int threads);
+  static void Evaluate(ScalingPoint &point);
+
+ private:
+  //  setup builds the inputs of one size, prepare runs before every
+  //  repetition, neither is timed. run(0) is the serial implementation.
+  struct Workload {
+    std::function<void(int size)> setup;
+    std::function<void()> prepare;
+    std::function<void(int threads)> run;
+    std::function<bool()> check;
+  };
+
+  ScalingOptions options_;
+  std::vector<ScalingPoint> points_;
+  std::map<std::pair<std::string, int>, double> serial_times_;
+
+  void RunWinograd_();
+  void RunGauss_();
+  void RunAnt_();
+  //  threads lists the counts to sweep, fixed-width modes pass just theirs
+  void Sweep_(const std::string &algorithm, const std::string &mode,
+              int base_size, const std::vector<int> &threads,
+              const Workload &workload);
+  double Time_(const Workload &workload, int threads, bool &valid) const;
+};
+}  // namespace s21
+
+#endif  // SRC_BENCHMARK_SCALING_H
@@ -0,0 +1,74 @@
+#include <iostream>
+#include <stdexcept>
+
+#include "../helpers/topology.h"
+#include "scaling.h"
+
+namespace {
+void PrintUsage() {
+  std::cout << "Usage: scaling [--max-threads N] [--size N] [--gauss-size N] "
+               "[--graph-size N]\n"
+               "               [--kind strong|weak|both] "
+               "[--algorithms winograd,gauss,ant]\n"
+               "               [--warmup N] [--reps N] [--seed N] "
+               "[--csv FILE]\n"
+               "               [--affinity none|compact|scatter|cores]\n";
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+  s21::ScalingOptions options;
+  for (int i = 1; i < argc; ++i) {
+    std::string key = argv[i];
+    if (key == "--help" || i + 1 >= argc) {
+      PrintUsage();
+      return key == "--help" ? 0 : 1;
+    }
+    std::string value = argv[++i];
+    try {
+      if (key == "--max-threads") {
+        options.max_threads = std::stoi(value);
+      } else if (key == "--size") {
+        options.matrix_size = std::stoi(value);
+      } else if (key == "--gauss-size") {
+        options.gauss_size = std::stoi(value);
+      } else if (key == "--graph-size") {
+        options.graph_size = std::stoi(value);
+      } else if (key == "--kind") {
+        options.strong = value == "strong" || value == "both";
+        options.weak = value == "weak" || value == "both";
+      } else if (key == "--algorithms") {
+        options.winograd = value.find("winograd") != std::string::npos;
+        options.gauss = value.find("gauss") != std::string::npos;
+        options.ant = value.find("ant") != std::string::npos;
+      } else if (key == "--warmup") {
+        options.warmup = std::stoi(value);
+      } else if (key == "--reps") {
+        options.repetitions = std::stoi(value);
+      } else if (key == "--seed") {
+        options.seed = (unsigned)std::stoul(value);
+      } else if (key == "--csv") {
+        options.csv_path = value;
+      } else if (key == "--affinity") {
+        s21::AffinityPolicy policy;
+        if (!s21::Topology::ParsePolicy(value, policy))
+          throw std::invalid_argument(key);
+        s21::Topology::SetPolicy(policy);
+      } else {
+        PrintUsage();
+        return 1;
+      }
+    } catch (std::exception &) {
+      std::cout << "Error! Wrong value for " << key << std::endl;
+      return 1;
+    }
+  }
+  if (options.repetitions < 1) options.repetitions = 1;
+
+  s21::ScalingReport report(options);
+  report.Run();
+  report.Print(std::cout);
+  if (!options.csv_path.empty() && !report.WriteCsv(options.csv_path))
+    std::cout << "Error! Can't write " << options.csv_path << std::endl;
+  return 0;
+}
@@ -0,0 +1,146 @@
+#include "autotuner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#include "topology.h"
+
+namespace s21 {
+std::mutex Autotuner::mutex_;
+std::map<std::string, TunedConfig> Autotuner::profile_;
+std::string Autotuner::path_ =
+    std::getenv("S21_AUTOTUNE_PROFILE") ? std::getenv("S21_AUTOTUNE_PROFILE")
+                                        : ".s21_autotune";
+bool Autotuner::loaded_ = false;
+
+//  Candidates are timed without the lock, so two threads tuning the same
+//  key both measure and the later one wins, which is harmless
+TunedConfig Autotuner::Select(
+    const std::string &key, const std::vector<TunedConfig> &candidates,
+    const std::function<double(const TunedConfig &)> &measure) {
+  TunedConfig best;
+  if (Lookup(key, best) || candidates.empty()) return best;
+  best = candidates.front();
+  best.seconds = -1;
+  for (const TunedConfig &candidate : candidates) {
+    double seconds = measure(candidate);
+    if (best.seconds < 0 || seconds < best.seconds) {
+      best = candidate;
+      best.seconds = seconds;
+    }
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  profile_[key] = best;
+  Save_();
+  return best;
+}
+
+bool Autotuner::Lookup(const std::string &key, TunedConfig &config) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Load_();
+  auto found = profile_.find(key);
+  if (found == profile_.end()) return false;
+  config = found->second;
+  return true;
+}
+
+std::string Autotuner::MakeKey(const std::string &algorithm,
+                               const std::vector<int> &sizes) {
+  std::ostringstream key;
+  key << algorithm << '/';
+  for (size_t i = 0; i < sizes.size(); ++i)
+    key << (i ? "x" : "") << ShapeClass(sizes[i]);
+  key << "@cpus" << Topology::Get().GetCpuCount();
+  return key.str();
+}
+
+int Autotuner::ShapeClass(int size) {
+  int shape = 1;
+  while (shape < size) shape *= 2;
+  return shape;
+}
+
+std::vector<int> Autotuner::ThreadCandidates() {
+  int max_threads = Topology::Get().GetMaxThreads();
+  std::vector<int> threads;
+  for (int count = 1; count < max_threads; count *= 2)
+    threads.push_back(count);
+  threads.push_back(max_threads);
+  return threads;
+}
+
+double Autotuner::Time(const std::function<void()> &run,
+                       const std::function<void()> &reset) {
+  std::vector<double> seconds;
+  for (int i = 0; i <= kRepetitions; ++i) {
+    if (reset) reset();
+    auto start_time = std::chrono::steady_clock::now();
+    run();
+    std::chrono::duration<double> duration =
+        std::chrono::steady_clock::now() - start_time;
+    if (i > 0) seconds.push_back(duration.count());
+  }
+  std::nth_element(seconds.begin(), seconds.begin() + seconds.size() / 2,
+                   seconds.end());
+  return seconds[seconds.size() / 2];
+}
+
+void Autotuner::SetProfilePath(const std::string &path) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  path_ = path;
+  profile_.clear();
+  loaded_ = false;
+}
+
+std::string Autotuner::GetProfilePath() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return path_;
+}
+
+void Autotuner::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  profile_.clear();
+  loaded_ = true;
+  if (!path_.empty()) std::remove(path_.c_str());
+}
+
+//  One "key variant threads block seconds" line per shape class, lines
+//  that don't parse are skipped
+void Autotuner::Load_() {
+  if (loaded_) return;
+  loaded_ = true;
+  if (path_.empty()) return;
+  std::ifstream file(path_);
+  std::string line;
+  while (std::getline(file, line)) {
+    if (line.empty() || line[0] == '#') continue;
+    std::istringstream fields(line);
+    std::string key;
+    TunedConfig config;
+    if (fields >> key >> config.variant >> config.threads >> config.block >>
+        config.seconds)
+      profile_[key] = config;
+  }
+}
+
+//  Written aside and renamed, a crash never leaves half a profile
+void Autotuner::Save_() {
+  if (path_.empty()) return;
+  std::string temporary = path_ + ".tmp";
+  {
+    std::ofstream file(temporary);
+    if (!file.is_open()) return;
+    file << "# s21 autotune profile: key variant threads block seconds\n";
+    for (const auto &entry : profile_)
+      file << entry.first << ' ' << entry.second.variant << ' '
+           << entry.second.threads << ' ' << entry.second.block << ' '
+           << entry.second.seconds << '\n';
+    if (!file) return;
+  }
+  std::rename(temporary.c_str(), path_.c_str());
+}
+}  // namespace s21
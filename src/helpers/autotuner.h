@@ -0,0 +1,64 @@
+#ifndef SRC_HELPERS_AUTOTUNER_H
+#define SRC_HELPERS_AUTOTUNER_H
+
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace s21 {
+
+//  One candidate configuration. What variant means is up to the caller,
+//  block is a tile size or 0 where the variant has none.
+struct TunedConfig {
+  int variant = 0;
+  int threads = 1;
+  int block = 0;
+  double seconds = 0;  //  measured time of the winner
+};
+
+//  Picks the fastest configuration per shape class. The first call for a
+//  key times every candidate, the winner is kept in memory and in a text
+//  profile file so later runs on the same host dispatch directly. Keys
+//  carry the CPU count, a profile copied to another machine is ignored
+//  rather than trusted.
+class Autotuner {
+ public:
+  static TunedConfig Select(const std::string &key,
+                            const std::vector<TunedConfig> &candidates,
+                            const std::function<double(const TunedConfig &)>
+                                &measure);
+  static bool Lookup(const std::string &key, TunedConfig &config);
+
+  //  "<algorithm>/<shape>@cpus<N>", sizes rounded up to a power of two
+  static std::string MakeKey(const std::string &algorithm,
+                             const std::vector<int> &sizes);
+  static int ShapeClass(int size);
+  //  1, 2, 4, ... and Topology::GetMaxThreads()
+  static std::vector<int> ThreadCandidates();
+  //  Median of kRepetitions timed runs after one untimed warm-up. reset,
+  //  if given, runs untimed before each of them, e.g. to restore an
+  //  operand that run modifies in place.
+  static constexpr int kRepetitions = 3;
+  static double Time(const std::function<void()> &run,
+                     const std::function<void()> &reset = nullptr);
+
+  //  Default is $S21_AUTOTUNE_PROFILE or .s21_autotune in the working
+  //  directory, an empty path keeps the profile in memory only
+  static void SetProfilePath(const std::string &path);
+  static std::string GetProfilePath();
+  static void Clear();  //  forgets every result and removes the file
+
+ private:
+  static std::mutex mutex_;
+  static std::map<std::string, TunedConfig> profile_;
+  static std::string path_;
+  static bool loaded_;
+
+  static void Load_();
+  static void Save_();
+};
+}  // namespace s21
+
+#endif  // SRC_HELPERS_AUTOTUNER_H
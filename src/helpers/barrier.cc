@@ -0,0 +1,17 @@
+#include "barrier.h"
+
+namespace s21 {
+Barrier::Barrier(int count) : count_(count) {}
+
+void Barrier::Wait() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  unsigned long generation = generation_;
+  if (++waiting_ == count_) {
+    waiting_ = 0;
+    generation_++;
+    cv_.notify_all();
+  } else {
+    cv_.wait(lock, [&]() { return generation != generation_; });
+  }
+}
+}  // namespace s21
@@ -0,0 +1,24 @@
+#ifndef SRC_HELPERS_BARRIER_H
+#define SRC_HELPERS_BARRIER_H
+
+#include <condition_variable>
+#include <mutex>
+
+namespace s21 {
+//  Reusable rendezvous point for a fixed team of threads
+class Barrier {
+ public:
+  explicit Barrier(int count);
+  ~Barrier() = default;
+
+  void Wait();
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  int count_, waiting_{};
+  unsigned long generation_{};
+};
+}  // namespace s21
+
+#endif  // SRC_HELPERS_BARRIER_H
@@ -0,0 +1,43 @@
+#include "cancellation.h"
+
+namespace s21 {
+CancellationToken CancellationToken::Create() {
+  CancellationToken token;
+  token.state_ = std::make_shared<State>();
+  return token;
+}
+
+//  The first reason sticks, a run that hit its deadline stays
+//  DEADLINE_EXCEEDED even if the caller cancels it afterwards
+void CancellationToken::Cancel() const {
+  if (!state_) return;
+  int expected = NOT_CANCELLED;
+  state_->reason.compare_exchange_strong(expected, CANCELLED_BY_CALLER);
+}
+
+void CancellationToken::SetDeadline(Clock::time_point deadline) const {
+  if (state_) state_->deadline = deadline.time_since_epoch().count();
+}
+
+void CancellationToken::SetTimeout(Clock::duration timeout) const {
+  SetDeadline(Clock::now() + timeout);
+}
+
+bool CancellationToken::IsCancelled() const {
+  if (!state_) return false;
+  if (state_->reason.load(std::memory_order_relaxed) != NOT_CANCELLED)
+    return true;
+  long long deadline = state_->deadline.load(std::memory_order_relaxed);
+  if (deadline == 0 || Clock::now().time_since_epoch().count() < deadline)
+    return false;
+  int expected = NOT_CANCELLED;
+  state_->reason.compare_exchange_strong(expected, DEADLINE_EXCEEDED);
+  return true;
+}
+
+CancellationReason CancellationToken::GetReason() const {
+  if (!state_) return NOT_CANCELLED;
+  IsCancelled();
+  return (CancellationReason)state_->reason.load();
+}
+}  // namespace s21
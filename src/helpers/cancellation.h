@@ -0,0 +1,44 @@
+#ifndef SRC_HELPERS_CANCELLATION_H
+#define SRC_HELPERS_CANCELLATION_H
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+namespace s21 {
+
+enum CancellationReason {
+  NOT_CANCELLED,
+  CANCELLED_BY_CALLER,
+  DEADLINE_EXCEEDED
+};
+
+//  Cooperative stop request shared by copies of the token. Algorithms poll
+//  IsCancelled() between pivots, rows or iterations and leave early. A
+//  default-constructed token can never be cancelled and costs one branch
+//  per poll, a token from Create() also reads the clock once a deadline
+//  is set.
+class CancellationToken {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  CancellationToken() = default;
+  static CancellationToken Create();
+
+  void Cancel() const;
+  void SetDeadline(Clock::time_point deadline) const;
+  void SetTimeout(Clock::duration timeout) const;
+  bool IsCancelled() const;
+  CancellationReason GetReason() const;
+  bool CanBeCancelled() const { return state_ != nullptr; }
+
+ private:
+  struct State {
+    std::atomic<int> reason{NOT_CANCELLED};
+    std::atomic<long long> deadline{0};  //  Clock ticks, 0 for none
+  };
+  std::shared_ptr<State> state_;
+};
+}  // namespace s21
+
+#endif  // SRC_HELPERS_CANCELLATION_H
@@ -1,6 +1,7 @@
 #include "matrix.h"
 
 #include <cmath>
+#include <utility>
 
 namespace s21 {
 
@@ -11,6 +12,13 @@ Matrix<T>::Matrix(int rows, int cols)
   if (!error_) CreateMatrix();
 }
 
+template <typename T>
+Matrix<T>::Matrix(int rows, int cols, const AllocationPolicy &policy)
+    : rows_(rows), cols_(cols), policy_(policy) {
+  if (rows_ < 0 || cols_ < 0) error_ = true;
+  if (!error_) CreateMatrix();
+}
+
 template <typename T>
 Matrix<T>::Matrix(int size) : rows_(size), cols_(size) {
   if (rows_ < 0 || cols_ < 0) error_ = true;
@@ -59,11 +67,16 @@ T Matrix<T>::RandomGenerate_() {
 
 template <typename T>
 Matrix<T>::Matrix(const Matrix &other)
-    : rows_(other.rows_), cols_(other.cols_) {
+    : rows_(other.rows_), cols_(other.cols_), policy_(other.policy_) {
   CreateMatrix();
   CopyMatrix(other);
 }
 
+template <typename T>
+Matrix<T>::Matrix(Matrix &&other) noexcept : policy_(other.policy_) {
+  Swap_(other);
+}
+
 template <typename T>
 Matrix<T>::~Matrix() {
   DeleteMatrix();
@@ -71,8 +84,11 @@ Matrix<T>::~Matrix() {
 
 template <typename T>
 void Matrix<T>::CreateMatrix() {
+  block_ = MatrixAllocator::Allocate(sizeof(T) * rows_ * cols_, rows_,
+                                     policy_);
+  data_ = static_cast<T *>(block_.data);
   matrix_ = new T *[rows_];
-  for (auto i = 0; i < rows_; i++) matrix_[i] = new T[cols_]();
+  for (auto i = 0; i < rows_; i++) matrix_[i] = data_ + (size_t)i * cols_;
 }
 
 template <typename T>
@@ -111,8 +127,9 @@ void Matrix<T>::ResizeMatrix(int rows, int cols) {
 template <typename T>
 void Matrix<T>::DeleteMatrix() {
   if (matrix_ != nullptr) {
-    for (auto i = 0; i < rows_; i++) delete[] matrix_[i];
+    MatrixAllocator::Deallocate(block_, policy_);
     delete[] matrix_;
+    data_ = nullptr;
     matrix_ = nullptr;
   }
   cols_ = 0;
@@ -156,6 +173,15 @@ Matrix<T> &Matrix<T>::operator=(const Matrix &other) {
   return *this;
 }
 
+template <typename T>
+Matrix<T> &Matrix<T>::operator=(Matrix &&other) noexcept {
+  if (&other != this) {
+    Swap_(other);
+    other.DeleteMatrix();
+  }
+  return *this;
+}
+
 template <typename T>
 T &Matrix<T>::operator()(int row, int col) {
   if (row >= rows_ || col >= cols_ || row < 0 || col < 0)
@@ -163,6 +189,18 @@ T &Matrix<T>::operator()(int row, int col) {
   return matrix_[row][col];
 }
 
+template <typename T>
+T *Matrix<T>::GetRow(int row) {
+  if (row >= rows_ || row < 0) throw std::range_error("Incorrect matrix size_");
+  return matrix_[row];
+}
+
+template <typename T>
+const T *Matrix<T>::GetRow(int row) const {
+  if (row >= rows_ || row < 0) throw std::range_error("Incorrect matrix size_");
+  return matrix_[row];
+}
+
 template <class T>
 bool Matrix<T>::operator==(const Matrix &other) {
   return IsEqualMatrix(other);
@@ -170,8 +208,9 @@ bool Matrix<T>::operator==(const Matrix &other) {
 
 template <class T>
 Matrix<T> Matrix<T>::operator*(const Matrix<T> &other) {
-  Matrix<T> result(*this);
-  result.MulMatrix(other);
+  if (this->cols_ != other.rows_) throw std::range_error("Error");
+  Matrix<T> result(this->rows_, other.cols_);
+  MulRows_(other, result);
   return result;
 }
 
@@ -179,20 +218,39 @@ template <class T>
 void Matrix<T>::MulMatrix(const Matrix<T> &other) {
   if (this->cols_ != other.rows_) throw std::range_error("Error");
   Matrix<T> result(this->rows_, other.cols_);
+  MulRows_(other, result);
+  Swap_(result);
+}
+
+//  Row of the result is accumulated from whole rows of other, so the
+//  inner loop streams both operands. Every element still sums its
+//  products in the same order as the textbook row by column loop.
+template <class T>
+void Matrix<T>::MulRows_(const Matrix<T> &other, Matrix<T> &result) const {
   for (auto row = 0; row < this->rows_; row++) {
-    for (auto col = 0; col < other.cols_; col++) {
-      for (auto col_t = 0; col_t < this->cols_; col_t++) {
-        result.matrix_[row][col] +=
-            this->matrix_[row][col_t] * other.matrix_[col_t][col];
-      }
+    T *result_row = result.matrix_[row];
+    for (auto col_t = 0; col_t < this->cols_; col_t++) {
+      T factor = this->matrix_[row][col_t];
+      const T *other_row = other.matrix_[col_t];
+      for (auto col = 0; col < other.cols_; col++)
+        result_row[col] += factor * other_row[col];
     }
   }
-  *this = result;
+}
+
+template <class T>
+void Matrix<T>::Swap_(Matrix &other) {
+  std::swap(rows_, other.rows_);
+  std::swap(cols_, other.cols_);
+  std::swap(matrix_, other.matrix_);
+  std::swap(data_, other.data_);
+  std::swap(policy_, other.policy_);
+  std::swap(block_, other.block_);
+  std::swap(error_, other.error_);
 }
 
 }  // namespace s21
 
-template class s21::Matrix<bool>;
 template class s21::Matrix<double>;
 template class s21::Matrix<float>;
 template class s21::Matrix<int>;
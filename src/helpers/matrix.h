@@ -2,15 +2,26 @@
 #define SRC_HELPERS_MATRIX_H
 
 #include <cmath>
+#include <cstdint>
 #include <cstring>
 #include <initializer_list>
 #include <iostream>
 #include <random>
 #include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "matrix_allocator.h"
 
 namespace s21 {
+template <class E>
+class MatrixExpression;
+
 template <class T>
 class Matrix {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "Matrix elements are copied with memcpy");
+
  public:
   [[nodiscard]] int GetRows() const;
   [[nodiscard]] int GetCols() const;
@@ -28,12 +39,27 @@ class Matrix {
   Matrix() = default;
   explicit Matrix(int size);
   Matrix(int rows, int cols);
+  Matrix(int rows, int cols, const AllocationPolicy &policy);
   Matrix(const Matrix &other);
+  Matrix(Matrix &&other) noexcept;
   Matrix(std::initializer_list<T> const &items);  // only for square matrix
+  //  Defined in matrix_expression.h, evaluated in a single pass
+  template <class E>
+  Matrix(const MatrixExpression<E> &expression);
 
   bool operator==(const Matrix &other);
   Matrix &operator=(const Matrix &other);
+  Matrix &operator=(Matrix &&other) noexcept;
+  template <class E>
+  Matrix &operator=(const MatrixExpression<E> &expression);
   T &operator()(int row, int col);
+  T *GetRow(int row);  // contiguous cols_ elements, checked once per row
+  const T *GetRow(int row) const;
+  //  Row i starts at GetData() + i * GetCols()
+  T *GetData() { return data_; }
+  const T *GetData() const { return data_; }
+  //  Kept by copies, a copy assignment keeps the policy of the destination
+  const AllocationPolicy &GetAllocationPolicy() const { return policy_; }
   Matrix<T> operator*(const Matrix<T> &other);
 
   ~Matrix();
@@ -41,14 +67,102 @@ class Matrix {
  private:
   int rows_{}, cols_{};
   T **matrix_{};
+  T *data_{};  //  all rows in one block, matrix_[i] points into it
   bool error_{false};
+  AllocationPolicy policy_ = MatrixAllocator::GetDefaultPolicy();
+  MemoryBlock block_;
 
   void CreateMatrix();
   void CopyMatrix(Matrix const &other);
   bool IsEqualSize(const Matrix &other);
   void InitMatrix(std::initializer_list<T> const &items);
+  void MulRows_(const Matrix<T> &other, Matrix<T> &result) const;
+  void Swap_(Matrix &other);
+  template <class E>
+  void Assign_(const E &expression);
   T RandomGenerate_();
 };
+
+//  Bit-packed boolean matrix, every row is padded to whole 64-bit words
+//  and the rows are stored one after another in a single allocation. The
+//  padding bits after the last column are always kept zero, so rows can
+//  be compared, counted and combined word by word.
+template <>
+class Matrix<bool> {
+ public:
+  using Word = std::uint64_t;
+  static constexpr int kWordBits = 64;
+
+  //  Stands in for bool & in operator(), a single bit can not be addressed
+  class Reference {
+   public:
+    Reference(Word *word, Word mask) : word_(word), mask_(mask) {}
+    operator bool() const { return (*word_ & mask_) != 0; }
+    Reference &operator=(bool value) {
+      if (value)
+        *word_ |= mask_;
+      else
+        *word_ &= ~mask_;
+      return *this;
+    }
+    Reference &operator=(const Reference &other) {
+      return *this = static_cast<bool>(other);
+    }
+    void Flip() { *word_ ^= mask_; }
+
+   private:
+    Word *word_;
+    Word mask_;
+  };
+
+  [[nodiscard]] int GetRows() const { return rows_; }
+  [[nodiscard]] int GetCols() const { return cols_; }
+  [[nodiscard]] int GetWordsPerRow() const { return words_per_row_; }
+  void SetRows(const int rows);
+  void SetCols(const int cols);
+  void ResizeMatrix(int rows, int cols);
+  bool GetError() { return error_; };
+  bool IsEqualMatrix(const Matrix &other);
+  void FillMatrix(bool value);
+  void FillRandomMatrix();
+  bool IsMatrixEmpty() { return rows_ == 0 && cols_ == 0; }
+  void MulMatrix(const Matrix<bool> &other);
+  void AndMatrix(const Matrix<bool> &other);
+  void OrMatrix(const Matrix<bool> &other);
+  void XorMatrix(const Matrix<bool> &other);
+  void TransitiveClosure();
+  [[nodiscard]] int CountRow(int row) const;
+  [[nodiscard]] long long CountAll() const;
+  void DeleteMatrix();
+
+  Matrix() = default;
+  explicit Matrix(int size);
+  Matrix(int rows, int cols);
+  Matrix(std::initializer_list<bool> const &items);  // only for square matrix
+
+  bool operator==(const Matrix &other);
+  Reference operator()(int row, int col);
+  bool operator()(int row, int col) const;
+  Word *GetRow(int row);  // GetWordsPerRow() words, checked once per row
+  const Word *GetRow(int row) const;
+  Matrix<bool> operator*(const Matrix<bool> &other);
+  Matrix<bool> operator&(const Matrix<bool> &other);
+  Matrix<bool> operator|(const Matrix<bool> &other);
+  Matrix<bool> operator^(const Matrix<bool> &other);
+
+ private:
+  //  Four Russians block, one table of 2^8 row combinations per 8 rows
+  static constexpr int kTableBits = 8;
+
+  int rows_{}, cols_{}, words_per_row_{};
+  std::vector<Word> words_;
+  bool error_{false};
+
+  void CreateMatrix();
+  void CheckIndex_(int row, int col) const;
+  void CheckEqualSize_(const Matrix &other) const;
+  Word LastWordMask_() const;
+};
 }  // namespace s21
 
 #endif  // SRC_HELPERS_MATRIX_H
@@ -0,0 +1,197 @@
+#include "matrix_allocator.h"
+
+#include <sys/mman.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "topology.h"
+
+namespace s21 {
+namespace {
+//  Constant-initialized, so matrices built during static initialization
+//  already see it
+constexpr AllocationPolicy kInitialPolicy{};
+}  // namespace
+
+std::mutex MatrixAllocator::mutex_;
+std::atomic<const AllocationPolicy *> MatrixAllocator::default_policy_{
+    &kInitialPolicy};
+std::list<AllocationPolicy> MatrixAllocator::policies_;
+std::multimap<std::size_t, MemoryBlock> MatrixAllocator::arena_;
+std::size_t MatrixAllocator::arena_bytes_ = 0;
+long long MatrixAllocator::arena_hits_ = 0;
+const bool MatrixAllocator::environment_applied_ =
+    MatrixAllocator::ApplyEnvironmentPolicy_();
+
+MemoryBlock MatrixAllocator::Allocate(std::size_t bytes, int rows,
+                                      const AllocationPolicy &policy) {
+  MemoryBlock block;
+  if (bytes == 0) return block;
+  if (policy.use_arena) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = arena_.find(bytes);
+    if (it != arena_.end()) {
+      block = it->second;
+      arena_.erase(it);
+      arena_bytes_ -= bytes;
+      arena_hits_++;
+    }
+  }
+  if (block.data == nullptr) block = AllocatePages_(bytes, policy);
+  Zero_(block, rows, policy.first_touch_threads);
+  return block;
+}
+
+MemoryBlock MatrixAllocator::AllocatePages_(std::size_t bytes,
+                                            const AllocationPolicy &policy) {
+  MemoryBlock block;
+  block.bytes = bytes;
+  std::size_t huge =
+      (bytes + kHugePageSize - 1) / kHugePageSize * kHugePageSize;
+#ifdef MAP_HUGETLB
+  if (policy.pages == EXPLICIT_HUGE_PAGES) {
+    void *data = mmap(nullptr, huge, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (data != MAP_FAILED) {
+      block.data = data;
+      block.mapped = true;
+      return block;
+    }
+  }
+#endif
+  //  Without reserved huge pages the explicit mode degrades to transparent
+  std::size_t alignment = policy.alignment < sizeof(void *)
+                              ? sizeof(void *)
+                              : policy.alignment,
+              size = bytes;
+  if (policy.pages != DEFAULT_PAGES) {
+    if (alignment < kHugePageSize) alignment = kHugePageSize;
+    size = huge;
+  }
+  size = (size + alignment - 1) / alignment * alignment;
+  block.data = std::aligned_alloc(alignment, size);
+  if (block.data == nullptr) throw std::bad_alloc();
+#ifdef MADV_HUGEPAGE
+  if (policy.pages != DEFAULT_PAGES) madvise(block.data, size, MADV_HUGEPAGE);
+#endif
+  return block;
+}
+
+//  Writing the zeroes is what places the pages, band i is written from the
+//  CPU that worker i of the algorithm is pinned to
+void MatrixAllocator::Zero_(MemoryBlock &block, int rows,
+                            int number_of_thread) {
+  char *data = static_cast<char *>(block.data);
+  if (number_of_thread > rows) number_of_thread = rows;
+  if (number_of_thread <= 1 || block.bytes < kFirstTouchMinBytes) {
+    std::memset(data, 0, block.bytes);
+    return;
+  }
+  std::size_t row_bytes = block.bytes / rows;
+  auto zero_band = [=](int band) {
+    std::size_t start = (std::size_t)band * rows / number_of_thread,
+                end = (std::size_t)(band + 1) * rows / number_of_thread;
+    std::memset(data + start * row_bytes, 0, (end - start) * row_bytes);
+  };
+  std::vector<int> placement = Topology::Get().Placement(number_of_thread);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < number_of_thread; ++i)
+    threads.push_back(Topology::StartThread(placement[i], zero_band, i));
+  for (auto &th : threads) th.join();
+}
+
+void MatrixAllocator::Deallocate(MemoryBlock &block,
+                                 const AllocationPolicy &policy) {
+  if (block.data == nullptr) return;
+  if (policy.use_arena) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (arena_bytes_ + block.bytes <= kArenaLimit &&
+        arena_.count(block.bytes) < kArenaBlocksPerSize) {
+      arena_.emplace(block.bytes, block);
+      arena_bytes_ += block.bytes;
+      block = MemoryBlock();
+      return;
+    }
+  }
+  Release_(block);
+}
+
+void MatrixAllocator::Release_(MemoryBlock &block) {
+  if (block.mapped) {
+    std::size_t huge =
+        (block.bytes + kHugePageSize - 1) / kHugePageSize * kHugePageSize;
+    munmap(block.data, huge);
+  } else {
+    std::free(block.data);
+  }
+  block = MemoryBlock();
+}
+
+void MatrixAllocator::SetDefaultPolicy(const AllocationPolicy &policy) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  policies_.push_back(policy);
+  default_policy_.store(&policies_.back(), std::memory_order_release);
+}
+
+AllocationPolicy MatrixAllocator::GetDefaultPolicy() {
+  return *default_policy_.load(std::memory_order_acquire);
+}
+
+bool MatrixAllocator::ParsePolicy(const std::string &spec,
+                                  AllocationPolicy &policy) {
+  AllocationPolicy parsed;
+  std::istringstream items(spec);
+  std::string item;
+  while (std::getline(items, item, ',')) {
+    if (item == "arena") {
+      parsed.use_arena = true;
+    } else if (item == "thp") {
+      parsed.pages = TRANSPARENT_HUGE_PAGES;
+    } else if (item == "hugetlb") {
+      parsed.pages = EXPLICIT_HUGE_PAGES;
+    } else if (item.compare(0, 12, "first-touch=") == 0) {
+      try {
+        parsed.first_touch_threads = std::stoi(item.substr(12));
+      } catch (std::exception &) {
+        return false;
+      }
+      if (parsed.first_touch_threads < 1) return false;
+    } else if (item != "default") {
+      return false;
+    }
+  }
+  policy = parsed;
+  return true;
+}
+
+//  A value that doesn't parse leaves the built-in default
+bool MatrixAllocator::ApplyEnvironmentPolicy_() {
+  const char *spec = std::getenv("S21_ALLOCATION");
+  AllocationPolicy policy;
+  if (spec == nullptr || !ParsePolicy(spec, policy)) return false;
+  SetDefaultPolicy(policy);
+  return true;
+}
+
+void MatrixAllocator::ClearArena() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto &item : arena_) Release_(item.second);
+  arena_.clear();
+  arena_bytes_ = 0;
+}
+
+std::size_t MatrixAllocator::GetArenaBytes() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return arena_bytes_;
+}
+
+long long MatrixAllocator::GetArenaHits() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return arena_hits_;
+}
+}  // namespace s21
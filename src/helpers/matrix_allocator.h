@@ -0,0 +1,77 @@
+#ifndef SRC_HELPERS_MATRIX_ALLOCATOR_H
+#define SRC_HELPERS_MATRIX_ALLOCATOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace s21 {
+
+enum PageMode { DEFAULT_PAGES, TRANSPARENT_HUGE_PAGES, EXPLICIT_HUGE_PAGES };
+
+struct AllocationPolicy {
+  std::size_t alignment = 64;
+  PageMode pages = DEFAULT_PAGES;
+  //  Rows are zeroed in this many bands, band i by its own thread with the
+  //  same i * rows / n split the parallel algorithms use, so on NUMA
+  //  machines every band lands on the node of the thread that works on it
+  int first_touch_threads = 1;
+  bool use_arena = false;  //  freed blocks are kept and handed out again
+};
+
+struct MemoryBlock {
+  void *data = nullptr;
+  std::size_t bytes = 0;
+  bool mapped = false;  //  from mmap, otherwise from aligned_alloc
+};
+
+//  Raw zeroed storage for Matrix<T>. The arena is shared by the whole
+//  process and only used by policies that ask for it, a block is only
+//  reused for a request of exactly its size. At most kArenaBlocksPerSize
+//  blocks of one size and kArenaLimit bytes in total are kept until
+//  ClearArena. Every Matrix reads the default policy, so it is read
+//  without the lock that guards the arena. It starts as $S21_ALLOCATION.
+class MatrixAllocator {
+ public:
+  static constexpr std::size_t kHugePageSize = 2 << 20;
+  static constexpr std::size_t kFirstTouchMinBytes = 1 << 20;
+  static constexpr std::size_t kArenaLimit = (std::size_t)1 << 30;
+  static constexpr std::size_t kArenaBlocksPerSize = 4;
+
+  static MemoryBlock Allocate(std::size_t bytes, int rows,
+                              const AllocationPolicy &policy);
+  static void Deallocate(MemoryBlock &block, const AllocationPolicy &policy);
+
+  static void SetDefaultPolicy(const AllocationPolicy &policy);
+  static AllocationPolicy GetDefaultPolicy();
+  //  Comma separated "default", "arena", "thp", "hugetlb" and
+  //  "first-touch=N" on top of the default AllocationPolicy, false for
+  //  anything else
+  static bool ParsePolicy(const std::string &spec, AllocationPolicy &policy);
+  static void ClearArena();
+  static std::size_t GetArenaBytes();
+  static long long GetArenaHits();
+
+ private:
+  static std::mutex mutex_;
+  //  Published snapshot, set policies are never freed because a reader
+  //  may still be copying an older one
+  static std::atomic<const AllocationPolicy *> default_policy_;
+  static std::list<AllocationPolicy> policies_;
+  static std::multimap<std::size_t, MemoryBlock> arena_;
+  static std::size_t arena_bytes_;
+  static long long arena_hits_;
+  static const bool environment_applied_;
+
+  static MemoryBlock AllocatePages_(std::size_t bytes,
+                                    const AllocationPolicy &policy);
+  static void Release_(MemoryBlock &block);
+  static void Zero_(MemoryBlock &block, int rows, int number_of_thread);
+  static bool ApplyEnvironmentPolicy_();
+};
+}  // namespace s21
+
+#endif  // SRC_HELPERS_MATRIX_ALLOCATOR_H
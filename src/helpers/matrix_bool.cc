@@ -0,0 +1,225 @@
+#include <algorithm>
+#include <random>
+
+#include "matrix.h"
+
+namespace s21 {
+
+Matrix<bool>::Matrix(int rows, int cols) : rows_(rows), cols_(cols) {
+  if (rows_ < 0 || cols_ < 0) error_ = true;
+  if (!error_) CreateMatrix();
+}
+
+Matrix<bool>::Matrix(int size) : Matrix(size, size) {}
+
+Matrix<bool>::Matrix(std::initializer_list<bool> const &items)
+    : rows_(sqrt(items.size())), cols_(sqrt(items.size())) {
+  if (fmod((items.size()), sqrt(items.size())) != 0) error_ = true;
+
+  if (!error_) {
+    CreateMatrix();
+    auto it = items.begin();
+    for (int i = 0; i < rows_; i++)
+      for (int j = 0; j < cols_; j++, it++) (*this)(i, j) = *it;
+  }
+}
+
+void Matrix<bool>::CreateMatrix() {
+  words_per_row_ = (cols_ + kWordBits - 1) / kWordBits;
+  words_.assign((size_t)rows_ * words_per_row_, 0);
+}
+
+//  Bits of the last word of a row that belong to real columns
+Matrix<bool>::Word Matrix<bool>::LastWordMask_() const {
+  int used = cols_ % kWordBits;
+  return used == 0 ? ~Word(0) : (Word(1) << used) - 1;
+}
+
+void Matrix<bool>::SetRows(const int rows) {
+  if (rows > 0 && rows != rows_) ResizeMatrix(rows, cols_);
+}
+
+void Matrix<bool>::SetCols(const int cols) {
+  if (cols > 0 && cols != cols_) ResizeMatrix(rows_, cols);
+}
+
+void Matrix<bool>::ResizeMatrix(int rows, int cols) {
+  if (cols > 0 && rows > 0) {
+    Matrix<bool> new_matrix(rows, cols);
+    int min_rows = (rows < rows_) ? rows : rows_;
+    int min_words = (new_matrix.words_per_row_ < words_per_row_)
+                        ? new_matrix.words_per_row_
+                        : words_per_row_;
+    for (int row = 0; row < min_rows; row++) {
+      Word *destination = new_matrix.GetRow(row);
+      std::memcpy(destination, GetRow(row), min_words * sizeof(Word));
+      if (min_words > 0)
+        destination[min_words - 1] &= new_matrix.LastWordMask_();
+    }
+    *this = std::move(new_matrix);
+  }
+}
+
+void Matrix<bool>::DeleteMatrix() {
+  words_.clear();
+  words_.shrink_to_fit();
+  rows_ = cols_ = words_per_row_ = 0;
+}
+
+bool Matrix<bool>::IsEqualMatrix(const Matrix &other) {
+  return rows_ == other.rows_ && cols_ == other.cols_ &&
+         words_ == other.words_;
+}
+
+bool Matrix<bool>::operator==(const Matrix &other) {
+  return IsEqualMatrix(other);
+}
+
+void Matrix<bool>::FillMatrix(bool value) {
+  std::fill(words_.begin(), words_.end(), value ? ~Word(0) : Word(0));
+  if (value && words_per_row_ > 0)
+    for (int i = 0; i < rows_; i++)
+      words_[(size_t)(i + 1) * words_per_row_ - 1] &= LastWordMask_();
+}
+
+void Matrix<bool>::FillRandomMatrix() {
+  std::random_device rd;
+  std::mt19937_64 engine(rd());
+  for (Word &word : words_) word = engine();
+  if (words_per_row_ > 0)
+    for (int i = 0; i < rows_; i++)
+      words_[(size_t)(i + 1) * words_per_row_ - 1] &= LastWordMask_();
+}
+
+void Matrix<bool>::CheckIndex_(int row, int col) const {
+  if (row >= rows_ || col >= cols_ || row < 0 || col < 0)
+    throw std::range_error("Incorrect matrix size_");
+}
+
+Matrix<bool>::Reference Matrix<bool>::operator()(int row, int col) {
+  CheckIndex_(row, col);
+  return Reference(&words_[(size_t)row * words_per_row_ + col / kWordBits],
+                   Word(1) << (col % kWordBits));
+}
+
+bool Matrix<bool>::operator()(int row, int col) const {
+  CheckIndex_(row, col);
+  return (words_[(size_t)row * words_per_row_ + col / kWordBits] >>
+          (col % kWordBits)) &
+         1;
+}
+
+Matrix<bool>::Word *Matrix<bool>::GetRow(int row) {
+  if (row >= rows_ || row < 0) throw std::range_error("Incorrect matrix size_");
+  return words_.data() + (size_t)row * words_per_row_;
+}
+
+const Matrix<bool>::Word *Matrix<bool>::GetRow(int row) const {
+  if (row >= rows_ || row < 0) throw std::range_error("Incorrect matrix size_");
+  return words_.data() + (size_t)row * words_per_row_;
+}
+
+int Matrix<bool>::CountRow(int row) const {
+  const Word *words = GetRow(row);
+  int count = 0;
+  for (int k = 0; k < words_per_row_; k++)
+    count += __builtin_popcountll(words[k]);
+  return count;
+}
+
+long long Matrix<bool>::CountAll() const {
+  long long count = 0;
+  for (Word word : words_) count += __builtin_popcountll(word);
+  return count;
+}
+
+void Matrix<bool>::CheckEqualSize_(const Matrix &other) const {
+  if (rows_ != other.rows_ || cols_ != other.cols_)
+    throw std::range_error("Error");
+}
+
+void Matrix<bool>::AndMatrix(const Matrix<bool> &other) {
+  CheckEqualSize_(other);
+  for (size_t k = 0; k < words_.size(); k++) words_[k] &= other.words_[k];
+}
+
+void Matrix<bool>::OrMatrix(const Matrix<bool> &other) {
+  CheckEqualSize_(other);
+  for (size_t k = 0; k < words_.size(); k++) words_[k] |= other.words_[k];
+}
+
+void Matrix<bool>::XorMatrix(const Matrix<bool> &other) {
+  CheckEqualSize_(other);
+  for (size_t k = 0; k < words_.size(); k++) words_[k] ^= other.words_[k];
+}
+
+Matrix<bool> Matrix<bool>::operator&(const Matrix<bool> &other) {
+  Matrix<bool> result(*this);
+  result.AndMatrix(other);
+  return result;
+}
+
+Matrix<bool> Matrix<bool>::operator|(const Matrix<bool> &other) {
+  Matrix<bool> result(*this);
+  result.OrMatrix(other);
+  return result;
+}
+
+Matrix<bool> Matrix<bool>::operator^(const Matrix<bool> &other) {
+  Matrix<bool> result(*this);
+  result.XorMatrix(other);
+  return result;
+}
+
+Matrix<bool> Matrix<bool>::operator*(const Matrix<bool> &other) {
+  Matrix<bool> result(*this);
+  result.MulMatrix(other);
+  return result;
+}
+
+//  Boolean product (OR of ANDs) by the method of Four Russians. The rows
+//  of other are taken kTableBits at a time, every OR combination of them
+//  is built once into a table and a row of the result then picks one table
+//  entry per block with kTableBits of its own bits as the index.
+void Matrix<bool>::MulMatrix(const Matrix<bool> &other) {
+  if (cols_ != other.rows_) throw std::range_error("Error");
+  Matrix<bool> result(rows_, other.cols_);
+  int width = other.words_per_row_;
+  std::vector<Word> table(((size_t)1 << kTableBits) * width);
+  for (int block = 0; block < cols_; block += kTableBits) {
+    int count = cols_ - block < kTableBits ? cols_ - block : kTableBits;
+    for (int mask = 1; mask < (1 << count); mask++) {
+      const Word *row = other.GetRow(block + __builtin_ctz(mask));
+      const Word *rest = &table[(size_t)(mask & (mask - 1)) * width];
+      Word *entry = &table[(size_t)mask * width];
+      for (int k = 0; k < width; k++) entry[k] = rest[k] | row[k];
+    }
+    int shift = block % kWordBits, word = block / kWordBits;
+    for (int i = 0; i < rows_; i++) {
+      int mask = (int)(GetRow(i)[word] >> shift) & ((1 << kTableBits) - 1);
+      if (mask == 0) continue;
+      const Word *entry = &table[(size_t)mask * width];
+      Word *destination = result.GetRow(i);
+      for (int k = 0; k < width; k++) destination[k] |= entry[k];
+    }
+  }
+  *this = std::move(result);
+}
+
+//  Warshall's algorithm with whole rows as bit sets: a row that reaches
+//  vertex k also reaches everything k reaches. Only for square matrices.
+void Matrix<bool>::TransitiveClosure() {
+  if (rows_ != cols_) throw std::range_error("Error");
+  for (int k = 0; k < rows_; k++) {
+    const Word *through = GetRow(k);
+    Word bit = Word(1) << (k % kWordBits);
+    int word = k / kWordBits;
+    for (int i = 0; i < rows_; i++) {
+      Word *row = GetRow(i);
+      if (!(row[word] & bit)) continue;
+      for (int w = 0; w < words_per_row_; w++) row[w] |= through[w];
+    }
+  }
+}
+
+}  // namespace s21
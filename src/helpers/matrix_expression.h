@@ -0,0 +1,293 @@
+#ifndef SRC_HELPERS_MATRIX_EXPRESSION_H
+#define SRC_HELPERS_MATRIX_EXPRESSION_H
+
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "matrix.h"
+#include "matrix_view.h"
+
+namespace s21 {
+//  Lazy arithmetic over Matrix<T> and MatrixView<T>. Operators build a
+//  tree of lightweight nodes that only hold references to their operands,
+//  nothing is computed until the tree is assigned to a Matrix or, with
+//  Assign(), to a view. The assignment then walks the destination once,
+//  row by row, and every node hands out a row object whose operator[]
+//  computes the element on the spot, so a whole chain such as
+//  2 * a - b + c is fused into a single loop.
+template <class E>
+class MatrixExpression {
+ public:
+  const E &Self() const { return static_cast<const E &>(*this); }
+};
+
+template <class T>
+class MatrixLeaf : public MatrixExpression<MatrixLeaf<T>> {
+ public:
+  using Value = T;
+
+  explicit MatrixLeaf(const Matrix<T> &matrix) : view_(matrix) {}
+  explicit MatrixLeaf(ConstMatrixView<T> view) : view_(view) {}
+
+  [[nodiscard]] int GetRows() const { return view_.GetRows(); }
+  [[nodiscard]] int GetCols() const { return view_.GetCols(); }
+  const T *Row(int row) const { return view_.GetRow(row); }
+  //  Element (i, j) is read before (i, j) of the destination is written
+  bool Aliases(const void *) const { return false; }
+
+ private:
+  ConstMatrixView<T> view_;
+};
+
+template <class L, class R, class Op>
+class MatrixBinary : public MatrixExpression<MatrixBinary<L, R, Op>> {
+ public:
+  using Value = typename L::Value;
+
+  class RowType {
+   public:
+    RowType(decltype(std::declval<const L &>().Row(0)) left,
+            decltype(std::declval<const R &>().Row(0)) right)
+        : left_(left), right_(right) {}
+    Value operator[](int col) const { return Op()(left_[col], right_[col]); }
+
+   private:
+    decltype(std::declval<const L &>().Row(0)) left_;
+    decltype(std::declval<const R &>().Row(0)) right_;
+  };
+
+  MatrixBinary(const L &left, const R &right) : left_(left), right_(right) {
+    if (left.GetRows() != right.GetRows() || left.GetCols() != right.GetCols())
+      throw std::range_error("Error");
+  }
+
+  [[nodiscard]] int GetRows() const { return left_.GetRows(); }
+  [[nodiscard]] int GetCols() const { return left_.GetCols(); }
+  RowType Row(int row) const {
+    return RowType(left_.Row(row), right_.Row(row));
+  }
+  bool Aliases(const void *matrix) const {
+    return left_.Aliases(matrix) || right_.Aliases(matrix);
+  }
+
+ private:
+  L left_;
+  R right_;
+};
+
+template <class E>
+class MatrixScaled : public MatrixExpression<MatrixScaled<E>> {
+ public:
+  using Value = typename E::Value;
+
+  class RowType {
+   public:
+    RowType(decltype(std::declval<const E &>().Row(0)) row, Value factor)
+        : row_(row), factor_(factor) {}
+    Value operator[](int col) const { return factor_ * row_[col]; }
+
+   private:
+    decltype(std::declval<const E &>().Row(0)) row_;
+    Value factor_;
+  };
+
+  MatrixScaled(const E &expression, Value factor)
+      : expression_(expression), factor_(factor) {}
+
+  [[nodiscard]] int GetRows() const { return expression_.GetRows(); }
+  [[nodiscard]] int GetCols() const { return expression_.GetCols(); }
+  RowType Row(int row) const { return RowType(expression_.Row(row), factor_); }
+  bool Aliases(const void *matrix) const {
+    return expression_.Aliases(matrix);
+  }
+
+ private:
+  E expression_;
+  Value factor_;
+};
+
+//  Matrix product as a node of a larger expression. Only one row of the
+//  product is kept at a time, it is computed when the row is requested.
+template <class T>
+class MatrixProduct : public MatrixExpression<MatrixProduct<T>> {
+ public:
+  using Value = T;
+
+  MatrixProduct(const Matrix<T> &left, const Matrix<T> &right)
+      : left_(left), right_(right) {
+    if (left.GetCols() != right.GetRows()) throw std::range_error("Error");
+  }
+
+  [[nodiscard]] int GetRows() const { return left_.GetRows(); }
+  [[nodiscard]] int GetCols() const { return right_.GetCols(); }
+  const T *Row(int row) const {
+    row_.assign(right_.GetCols(), T());
+    const T *left_row = left_.GetRow(row);
+    for (int k = 0; k < left_.GetCols(); k++) {
+      T factor = left_row[k];
+      const T *right_row = right_.GetRow(k);
+      for (int j = 0; j < right_.GetCols(); j++)
+        row_[j] += factor * right_row[j];
+    }
+    return row_.data();
+  }
+  //  Later rows of the product still need all of right and their own
+  //  row of left, so writing into either of them is unsafe
+  bool Aliases(const void *matrix) const {
+    return matrix == &left_ || matrix == &right_;
+  }
+
+ private:
+  const Matrix<T> &left_;
+  const Matrix<T> &right_;
+  mutable std::vector<T> row_;
+};
+
+template <class X>
+struct IsMatrixOperand
+    : std::is_base_of<MatrixExpression<std::decay_t<X>>, std::decay_t<X>> {};
+template <class T>
+struct IsMatrixOperand<Matrix<T>> : std::true_type {};
+template <class T>
+struct IsMatrixOperand<const Matrix<T>> : std::true_type {};
+template <class T>
+struct IsMatrixOperand<MatrixView<T>> : std::true_type {};
+
+template <class T>
+MatrixLeaf<T> AsExpression(const Matrix<T> &matrix) {
+  return MatrixLeaf<T>(matrix);
+}
+
+template <class T>
+MatrixLeaf<std::remove_const_t<T>> AsExpression(const MatrixView<T> &view) {
+  return MatrixLeaf<std::remove_const_t<T>>(
+      ConstMatrixView<std::remove_const_t<T>>(view));
+}
+
+template <class E>
+const E &AsExpression(const MatrixExpression<E> &expression) {
+  return expression.Self();
+}
+
+template <class X>
+using ExpressionOf = std::decay_t<decltype(AsExpression(std::declval<X>()))>;
+
+template <class L, class R,
+          class = std::enable_if_t<IsMatrixOperand<L>::value &&
+                                   IsMatrixOperand<R>::value>>
+MatrixBinary<ExpressionOf<L>, ExpressionOf<R>, std::plus<>> operator+(
+    const L &left, const R &right) {
+  return {AsExpression(left), AsExpression(right)};
+}
+
+template <class L, class R,
+          class = std::enable_if_t<IsMatrixOperand<L>::value &&
+                                   IsMatrixOperand<R>::value>>
+MatrixBinary<ExpressionOf<L>, ExpressionOf<R>, std::minus<>> operator-(
+    const L &left, const R &right) {
+  return {AsExpression(left), AsExpression(right)};
+}
+
+//  Element-wise product, operator* between matrices stays the matrix product
+template <class L, class R,
+          class = std::enable_if_t<IsMatrixOperand<L>::value &&
+                                   IsMatrixOperand<R>::value>>
+MatrixBinary<ExpressionOf<L>, ExpressionOf<R>, std::multiplies<>> Hadamard(
+    const L &left, const R &right) {
+  return {AsExpression(left), AsExpression(right)};
+}
+
+template <class E, class S,
+          class = std::enable_if_t<IsMatrixOperand<E>::value &&
+                                   std::is_arithmetic<S>::value>>
+MatrixScaled<ExpressionOf<E>> operator*(S factor, const E &expression) {
+  return {AsExpression(expression),
+          static_cast<typename ExpressionOf<E>::Value>(factor)};
+}
+
+template <class E, class S,
+          class = std::enable_if_t<IsMatrixOperand<E>::value &&
+                                   std::is_arithmetic<S>::value>>
+MatrixScaled<ExpressionOf<E>> operator*(const E &expression, S factor) {
+  return factor * expression;
+}
+
+template <class E, class = std::enable_if_t<IsMatrixOperand<E>::value>>
+MatrixScaled<ExpressionOf<E>> operator-(const E &expression) {
+  return -1 * expression;
+}
+
+template <class T>
+MatrixProduct<T> Product(const Matrix<T> &left, const Matrix<T> &right) {
+  return MatrixProduct<T>(left, right);
+}
+
+//  result = alpha * left * right + beta * result without any temporary,
+//  see the view overload in matrix_view.h. Result must not be an operand.
+template <class T>
+void Gemm(T alpha, const Matrix<T> &left, const Matrix<T> &right, T beta,
+          Matrix<T> &result) {
+  if (&result == &left || &result == &right) throw std::range_error("Error");
+  Gemm<T>(alpha, ConstMatrixView<T>(left), ConstMatrixView<T>(right), beta,
+          MatrixView<T>(result));
+}
+
+//  Evaluates expression straight into a block of a larger matrix. Unlike
+//  Matrix::operator= nothing checks for aliasing: an operand may only
+//  overlap destination element for element and never through a Product.
+template <class T, class E>
+void Assign(MatrixView<T> destination, const MatrixExpression<E> &expression) {
+  const E &self = expression.Self();
+  if (destination.GetRows() != self.GetRows() ||
+      destination.GetCols() != self.GetCols())
+    throw std::range_error("Error");
+  for (int i = 0; i < destination.GetRows(); i++) {
+    auto row = self.Row(i);
+    T *target = destination.GetRow(i);
+    for (int j = 0; j < destination.GetCols(); j++) target[j] = row[j];
+  }
+}
+
+template <class T>
+template <class E>
+Matrix<T>::Matrix(const MatrixExpression<E> &expression)
+    : rows_(expression.Self().GetRows()), cols_(expression.Self().GetCols()) {
+  CreateMatrix();
+  Assign_(expression.Self());
+}
+
+//  The destination is only reallocated when its size changes, an
+//  expression that reads it in an unsafe way is evaluated aside first
+template <class T>
+template <class E>
+Matrix<T> &Matrix<T>::operator=(const MatrixExpression<E> &expression) {
+  const E &self = expression.Self();
+  if (self.Aliases(this)) {
+    Matrix<T> result(expression);
+    Swap_(result);
+  } else {
+    if (rows_ != self.GetRows() || cols_ != self.GetCols()) {
+      DeleteMatrix();
+      rows_ = self.GetRows();
+      cols_ = self.GetCols();
+      CreateMatrix();
+    }
+    Assign_(self);
+  }
+  return *this;
+}
+
+template <class T>
+template <class E>
+void Matrix<T>::Assign_(const E &expression) {
+  for (int i = 0; i < rows_; i++) {
+    auto row = expression.Row(i);
+    T *destination = matrix_[i];
+    for (int j = 0; j < cols_; j++) destination[j] = row[j];
+  }
+}
+}  // namespace s21
+
+#endif  // SRC_HELPERS_MATRIX_EXPRESSION_H
@@ -1,5 +1,9 @@
 #include "matrix_parser.h"
 
+#include <unistd.h>
+
+#include <atomic>
+
 namespace s21 {
 MatrixParser::MatrixParser() = default;
 MatrixParser::~MatrixParser() = default;
@@ -8,9 +12,11 @@ Matrix<double> MatrixParser::LoadMatrixFromFile(const std::string &filename) {
   Matrix<double> tmp_matrix_;
   std::ifstream file(filename);
   if (tmp_matrix_.GetRows() != 0) tmp_matrix_.DeleteMatrix();
+  ResetStatistics_();
   if (file.is_open()) {
     error_ = false;
     std::string line;
+    std::vector<double> values;
     int row = 0, rows = 0, cols = 0;
     bool flag = true;
     while (getline(file, line) && (row < tmp_matrix_.GetRows() || flag) &&
@@ -18,29 +24,175 @@ Matrix<double> MatrixParser::LoadMatrixFromFile(const std::string &filename) {
       if (flag) {
         flag = false;
         GetSizeOfMatrix_(line, rows, cols);
+        block_ = rows < cols ? rows : cols;
+        structure_.lower_bandwidth = structure_.upper_bandwidth = 0;
         tmp_matrix_ = Matrix<double>(rows, cols);
+        values.assign(cols, 0);
       } else if (line.length() > 1) {
-        int pos = 0;
-        for (int col = 0; col < tmp_matrix_.GetCols(); ++col) {
-          if (line[pos] == ' ' || line[pos] == ',') {
-            pos++;
-            col--;
-          } else {
-            double num = ParsingValue_(pos, line);
-            tmp_matrix_(row, col) = num;
-            pos += GetLengthDouble_(num) + 1;
-          }
-        }
+        ParseRow_(line, row, values);
+        for (int col = 0; col < tmp_matrix_.GetCols(); ++col)
+          tmp_matrix_(row, col) = values[col];
         row++;
       }
     }
     file.close();
+    SetDensity_();
   } else {
     error_ = true;
   }
   return tmp_matrix_;
 }
 
+bool MatrixParser::LoadSystemFromFile(const std::string &filename,
+                                      LinearSystem &system,
+                                      int min_sparse_rows) {
+  std::ifstream file(filename);
+  system = LinearSystem();
+  ResetStatistics_();
+  error_ = !file.is_open();
+  std::string line;
+  std::vector<double> values;
+  std::vector<std::pair<int, double>> entries;
+  int row = 0, rows = 0, cols = 0;
+  bool flag = true;
+  while (!error_ && (row < rows || flag) && getline(file, line)) {
+    if (flag) {
+      flag = false;
+      GetSizeOfMatrix_(line, rows, cols);
+      block_ = rows < cols ? rows : cols;
+      structure_.lower_bandwidth = structure_.upper_bandwidth = 0;
+      values.assign(cols, 0);
+      system.is_sparse = cols == rows + 1 && rows >= min_sparse_rows;
+      if (system.is_sparse) {
+        system.coefficients = SparseMatrix<double>(rows, rows);
+        system.right.assign(rows, 0);
+      } else {
+        system.dense = Matrix<double>(rows, cols);
+      }
+    } else if (line.length() > 1) {
+      ParseRow_(line, row, values);
+      if (system.is_sparse &&
+          non_zeros_ >= MatrixStructure::kSparseDensityThreshold * rows * rows)
+        MoveToDense_(system, row, cols);
+      if (system.is_sparse) {
+        entries.clear();
+        for (int col = 0; col < rows; ++col)
+          if (values[col] != 0) entries.push_back({col, values[col]});
+        system.coefficients.AppendRow(entries);
+        system.right[row] = values[rows];
+      } else {
+        double *destination = system.dense.GetRow(row);
+        for (int col = 0; col < cols; ++col) destination[col] = values[col];
+      }
+      row++;
+    }
+  }
+  for (; system.is_sparse && row < rows; ++row)
+    system.coefficients.AppendRow({});
+  SetDensity_();
+  return !error_;
+}
+
+Matrix<double> MatrixParser::LoadBinaryMatrixFromFile(
+    const std::string &filename) {
+  ResetStatistics_();
+  error_ = true;
+  std::ifstream file(filename, std::ios::binary);
+  char magic[4] = {};
+  uint32_t version = 0;
+  int32_t rows = 0, cols = 0;
+  file.read(magic, sizeof(magic));
+  file.read(reinterpret_cast<char *>(&version), sizeof(version));
+  file.read(reinterpret_cast<char *>(&rows), sizeof(rows));
+  file.read(reinterpret_cast<char *>(&cols), sizeof(cols));
+  if (!file || std::memcmp(magic, kBinaryMagic, sizeof(magic)) != 0 ||
+      version != kBinaryVersion || rows < 1 || cols < 1)
+    return Matrix<double>();
+  Matrix<double> matrix(rows, cols);
+  file.read(reinterpret_cast<char *>(matrix.GetData()),
+            (std::streamsize)(sizeof(double) * rows * cols));
+  if (!file) return Matrix<double>();
+  error_ = false;
+  return matrix;
+}
+
+bool MatrixParser::SaveBinaryMatrixToFile(const Matrix<double> &matrix,
+                                          const std::string &filename) {
+  //  Unique per process and call, writers of the same file don't collide
+  static std::atomic<unsigned> counter{0};
+  std::string temporary = filename + "." + std::to_string(getpid()) + "." +
+                          std::to_string(counter++) + ".tmp";
+  {
+    std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+    int32_t rows = matrix.GetRows(), cols = matrix.GetCols();
+    file.write(kBinaryMagic, sizeof(kBinaryMagic));
+    file.write(reinterpret_cast<const char *>(&kBinaryVersion),
+               sizeof(kBinaryVersion));
+    file.write(reinterpret_cast<const char *>(&rows), sizeof(rows));
+    file.write(reinterpret_cast<const char *>(&cols), sizeof(cols));
+    file.write(reinterpret_cast<const char *>(matrix.GetData()),
+               (std::streamsize)(sizeof(double) * rows * cols));
+    if (!file) {
+      std::remove(temporary.c_str());
+      return false;
+    }
+  }
+  return std::rename(temporary.c_str(), filename.c_str()) == 0;
+}
+
+void MatrixParser::SetDensity_() {
+  if (!error_ && block_ > 0)
+    structure_.density = (double)non_zeros_ / block_ / block_;
+  else
+    structure_ = MatrixStructure();
+}
+
+//  The first rows of system, which are in CSR form, become the leading
+//  rows of a dense matrix and the CSR storage is released
+void MatrixParser::MoveToDense_(LinearSystem &system, int rows, int cols) {
+  system.dense = Matrix<double>(system.coefficients.GetRows(), cols);
+  const std::vector<int> &row_start = system.coefficients.GetRowStart();
+  const std::vector<int> &col_index = system.coefficients.GetColIndex();
+  const std::vector<double> &values = system.coefficients.GetValues();
+  for (int i = 0; i < rows; ++i) {
+    double *destination = system.dense.GetRow(i);
+    for (int k = row_start[i]; k < row_start[i + 1]; ++k)
+      destination[col_index[k]] = values[k];
+    destination[cols - 1] = system.right[i];
+  }
+  system.is_sparse = false;
+  system.coefficients = SparseMatrix<double>();
+  system.right = std::vector<double>();
+}
+
+void MatrixParser::ResetStatistics_() {
+  non_zeros_ = 0;
+  block_ = 0;
+  structure_ = MatrixStructure();
+}
+
+void MatrixParser::ParseRow_(const std::string &line, int row,
+                             std::vector<double> &values) {
+  int pos = 0;
+  for (int col = 0; col < (int)values.size(); ++col) {
+    if (line[pos] == ' ' || line[pos] == ',') {
+      pos++;
+      col--;
+    } else {
+      double num = ParsingValue_(pos, line);
+      values[col] = num;
+      if (num != 0 && col < block_ && row < block_) {
+        non_zeros_++;
+        if (row - col > structure_.lower_bandwidth)
+          structure_.lower_bandwidth = row - col;
+        if (col - row > structure_.upper_bandwidth)
+          structure_.upper_bandwidth = col - row;
+      }
+      pos += GetLengthDouble_(num) + 1;
+    }
+  }
+}
+
 double MatrixParser::ParsingValue_(int pos, std::string line) {
   double result = 0;
   try {
@@ -2,23 +2,65 @@
 #define SRC_HELPERS_MATRIX_PARSER_H
 
 #include <cmath>
+#include <cstdint>
 #include <cstdio>
 #include <fstream>
 #include <string>
+#include <vector>
 
 #include "matrix.h"
+#include "matrix_structure.h"
+#include "sparse_matrix.h"
 
 namespace s21 {
 
+//  An augmented n x (n + 1) system as MatrixParser::LoadSystemFromFile
+//  read it: n x n coefficients in CSR form with the right-hand side apart,
+//  or the whole matrix in dense form
+struct LinearSystem {
+  bool is_sparse = false;
+  SparseMatrix<double> coefficients;
+  std::vector<double> right;
+  Matrix<double> dense;
+};
+
 class MatrixParser {
  public:
   MatrixParser();
   ~MatrixParser();
+
   Matrix<double> LoadMatrixFromFile(const std::string &filename);
+  //  Same text format. An n x (n + 1) system with at least min_sparse_rows
+  //  rows is kept in CSR form for as long as its coefficients can still
+  //  turn out sparse, so a sparse system never costs n * (n + 1) doubles.
+  //  Once the non-zero count rules that out, the rows read so far move to
+  //  system.dense, which takes the rest of the file as well.
+  bool LoadSystemFromFile(const std::string &filename, LinearSystem &system,
+                          int min_sparse_rows = 0);
+  //  "S21M", uint32 version, int32 rows, int32 cols, then rows * cols
+  //  doubles, all in the byte order of the host. Saving goes through a
+  //  temporary file, a reader never sees half a matrix.
+  Matrix<double> LoadBinaryMatrixFromFile(const std::string &filename);
+  static bool SaveBinaryMatrixToFile(const Matrix<double> &matrix,
+                                     const std::string &filename);
+  static constexpr char kBinaryMagic[4] = {'S', '2', '1', 'M'};
+  static constexpr uint32_t kBinaryVersion = 1;
   bool GetError() { return error_; }
+  //  Of the last text file read, GaussAlgorithm takes it to pick the
+  //  banded or sparse solver without scanning the matrix again. Unknown
+  //  after an error and for binary files.
+  const MatrixStructure &GetStructure() const { return structure_; }
 
  private:
   bool error_{};
+  long long non_zeros_{};
+  int block_{};  //  side of the leading square block
+  MatrixStructure structure_;
+  void ResetStatistics_();
+  void SetDensity_();
+  static void MoveToDense_(LinearSystem &system, int rows, int cols);
+  void ParseRow_(const std::string &line, int row,
+                 std::vector<double> &values);
   double ParsingValue_(int pos, std::string line);
   void GetSizeOfMatrix_(std::string line, int &rows, int &cols);
   int GetLengthDouble_(double num);
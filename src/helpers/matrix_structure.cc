@@ -0,0 +1,26 @@
+#include "matrix_structure.h"
+
+#include <algorithm>
+
+namespace s21 {
+MatrixStructure MatrixStructure::Scan(const Matrix<double> &matrix) {
+  MatrixStructure structure;
+  int size = std::min(matrix.GetRows(), matrix.GetCols());
+  if (size < 1) return structure;
+  long long non_zeros = 0;
+  int lower = 0, upper = 0;
+  for (int i = 0; i < size; ++i) {
+    const double *row = matrix.GetRow(i);
+    for (int j = 0; j < size; ++j) {
+      if (row[j] == 0) continue;
+      ++non_zeros;
+      if (i - j > lower) lower = i - j;
+      if (j - i > upper) upper = j - i;
+    }
+  }
+  structure.lower_bandwidth = lower;
+  structure.upper_bandwidth = upper;
+  structure.density = (double)non_zeros / ((double)size * size);
+  return structure;
+}
+}  // namespace s21
@@ -0,0 +1,28 @@
+#ifndef SRC_HELPERS_MATRIX_STRUCTURE_H
+#define SRC_HELPERS_MATRIX_STRUCTURE_H
+
+#include "matrix.h"
+
+namespace s21 {
+
+//  Where the non-zero values of the leading square block of a matrix lie,
+//  so the right-hand side of an augmented system is ignored. MatrixParser
+//  fills it while reading a file, Scan() takes one pass over a matrix that
+//  was built in memory. The bandwidths stay -1 while nothing is known.
+struct MatrixStructure {
+  //  Matrices with less non-zero values are worth keeping in sparse form
+  static constexpr double kSparseDensityThreshold = 0.1;
+
+  int lower_bandwidth = -1;
+  int upper_bandwidth = -1;
+  double density = 1;
+
+  [[nodiscard]] bool IsKnown() const { return lower_bandwidth >= 0; }
+  [[nodiscard]] bool IsSparse() const {
+    return IsKnown() && density < kSparseDensityThreshold;
+  }
+  static MatrixStructure Scan(const Matrix<double> &matrix);
+};
+}  // namespace s21
+
+#endif  // SRC_HELPERS_MATRIX_STRUCTURE_H
@@ -0,0 +1,157 @@
+#ifndef SRC_HELPERS_MATRIX_VIEW_H
+#define SRC_HELPERS_MATRIX_VIEW_H
+
+#include <array>
+#include <stdexcept>
+#include <type_traits>
+
+#include "matrix.h"
+
+namespace s21 {
+//  Non-owning window into row-major storage: element (i, j) lives at
+//  data[i * stride + j]. Taking a block or a slice only adjusts the pointer,
+//  the dimensions and the stride, so blocked kernels can recurse into
+//  sub-blocks without copying. A view must not outlive the matrix it was
+//  taken from, and resizing that matrix invalidates it.
+template <class T>
+class MatrixView {
+ public:
+  using Element = std::remove_const_t<T>;
+
+  MatrixView() = default;
+  MatrixView(T *data, int rows, int cols, int stride)
+      : data_(data), rows_(rows), cols_(cols), stride_(stride) {
+    if (rows < 0 || cols < 0 || stride < cols)
+      throw std::range_error("Incorrect matrix size_");
+  }
+  MatrixView(Matrix<Element> &matrix)
+      : MatrixView(matrix.GetData(), matrix.GetRows(), matrix.GetCols(),
+                   matrix.GetCols()) {}
+  template <class U = T, class = std::enable_if_t<std::is_const<U>::value>>
+  MatrixView(const Matrix<Element> &matrix)
+      : MatrixView(matrix.GetData(), matrix.GetRows(), matrix.GetCols(),
+                   matrix.GetCols()) {}
+  template <class U = T, class = std::enable_if_t<std::is_const<U>::value>>
+  MatrixView(const MatrixView<Element> &other)
+      : data_(other.GetData()),
+        rows_(other.GetRows()),
+        cols_(other.GetCols()),
+        stride_(other.GetStride()) {}
+
+  [[nodiscard]] int GetRows() const { return rows_; }
+  [[nodiscard]] int GetCols() const { return cols_; }
+  [[nodiscard]] int GetStride() const { return stride_; }
+  T *GetData() const { return data_; }
+  bool IsEmpty() const { return rows_ == 0 || cols_ == 0; }
+
+  T &operator()(int row, int col) const {
+    if (row >= rows_ || col >= cols_ || row < 0 || col < 0)
+      throw std::range_error("Incorrect matrix size_");
+    return data_[(size_t)row * stride_ + col];
+  }
+  T *GetRow(int row) const {
+    if (row >= rows_ || row < 0)
+      throw std::range_error("Incorrect matrix size_");
+    return data_ + (size_t)row * stride_;
+  }
+
+  MatrixView Block(int row, int col, int rows, int cols) const {
+    if (row < 0 || col < 0 || rows < 0 || cols < 0 || row + rows > rows_ ||
+        col + cols > cols_)
+      throw std::range_error("Incorrect matrix size_");
+    return MatrixView(data_ + (size_t)row * stride_ + col, rows, cols, stride_);
+  }
+  //  Every step-th row starting from first, count rows in total
+  MatrixView SliceRows(int first, int count, int step = 1) const {
+    if (first < 0 || count < 0 || step < 1 ||
+        (count > 0 && first + (count - 1) * step >= rows_))
+      throw std::range_error("Incorrect matrix size_");
+    return MatrixView(data_ + (size_t)first * stride_, count, cols_,
+                      stride_ * step);
+  }
+  //  Top left, top right, bottom left and bottom right; the first row and
+  //  column halves get the extra line of an odd dimension
+  std::array<MatrixView, 4> Quadrants() const {
+    int top = (rows_ + 1) / 2, left = (cols_ + 1) / 2;
+    return {Block(0, 0, top, left), Block(0, left, top, cols_ - left),
+            Block(top, 0, rows_ - top, left),
+            Block(top, left, rows_ - top, cols_ - left)};
+  }
+
+  //  Calls function(block, row, col) for consecutive tiles of at most
+  //  block_rows x block_cols, row and col are the tile origin in this view
+  template <class F>
+  void ForEachBlock(int block_rows, int block_cols, F function) const {
+    if (block_rows < 1 || block_cols < 1)
+      throw std::range_error("Incorrect matrix size_");
+    for (int i = 0; i < rows_; i += block_rows)
+      for (int j = 0; j < cols_; j += block_cols)
+        function(Block(i, j, block_rows < rows_ - i ? block_rows : rows_ - i,
+                       block_cols < cols_ - j ? block_cols : cols_ - j),
+                 i, j);
+  }
+
+  void Fill(Element value) const {
+    for (int i = 0; i < rows_; i++) {
+      T *row = data_ + (size_t)i * stride_;
+      for (int j = 0; j < cols_; j++) row[j] = value;
+    }
+  }
+  void CopyTo(const MatrixView<Element> &destination) const {
+    if (destination.GetRows() != rows_ || destination.GetCols() != cols_)
+      throw std::range_error("Error");
+    for (int i = 0; i < rows_; i++) {
+      const T *source = data_ + (size_t)i * stride_;
+      Element *target = destination.GetRow(i);
+      for (int j = 0; j < cols_; j++) target[j] = source[j];
+    }
+  }
+
+ private:
+  T *data_{};
+  int rows_{}, cols_{}, stride_{};
+};
+
+template <class T>
+using ConstMatrixView = MatrixView<const T>;
+
+//  result = alpha * left * right + beta * result on views. The shared
+//  dimension is walked in panels of panel_rows rows of right, so a panel
+//  is reused from cache for every row of left. As in BLAS a zero beta
+//  ignores the old contents of result, result must not overlap the
+//  operands.
+constexpr int kGemmPanel = 64;
+
+template <class T>
+void Gemm(T alpha, ConstMatrixView<T> left, ConstMatrixView<T> right, T beta,
+          MatrixView<T> result, int panel_rows = kGemmPanel) {
+  if (left.GetCols() != right.GetRows() ||
+      result.GetRows() != left.GetRows() || result.GetCols() != right.GetCols())
+    throw std::range_error("Error");
+  if (beta == T())
+    result.Fill(T());
+  else if (beta != T(1))
+    for (int i = 0; i < result.GetRows(); i++) {
+      T *row = result.GetRow(i);
+      for (int j = 0; j < result.GetCols(); j++) row[j] *= beta;
+    }
+  int cols = result.GetCols();
+  if (panel_rows < 1) panel_rows = kGemmPanel;
+  for (int panel = 0; panel < left.GetCols(); panel += panel_rows) {
+    int end = panel + panel_rows < left.GetCols() ? panel + panel_rows
+                                                  : left.GetCols();
+    for (int i = 0; i < result.GetRows(); i++) {
+      T *result_row = result.GetRow(i);
+      const T *left_row = left.GetRow(i);
+      for (int k = panel; k < end; k++) {
+        T factor = alpha * left_row[k];
+        if (factor == T()) continue;
+        const T *right_row = right.GetRow(k);
+        for (int j = 0; j < cols; j++) result_row[j] += factor * right_row[j];
+      }
+    }
+  }
+}
+}  // namespace s21
+
+#endif  // SRC_HELPERS_MATRIX_VIEW_H
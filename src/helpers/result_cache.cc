@@ -0,0 +1,283 @@
+#include "result_cache.h"
+
+#include <sys/stat.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+#include "matrix_parser.h"
+
+namespace s21 {
+namespace {
+constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t kPrime3 = 0x165667B19E3779F9ULL;
+constexpr uint64_t kPrime4 = 0x85EBCA77C2B2AE63ULL;
+constexpr uint64_t kPrime5 = 0x27D4EB2F165667C5ULL;
+constexpr uint64_t kSecondSeed = 0x5332314B45590001ULL;
+
+uint64_t Rotate(uint64_t value, int bits) {
+  return (value << bits) | (value >> (64 - bits));
+}
+
+template <class T>
+uint64_t Read(const unsigned char *data) {
+  T value;
+  std::memcpy(&value, data, sizeof(T));
+  return value;
+}
+
+uint64_t Round(uint64_t accumulator, uint64_t input) {
+  return Rotate(accumulator + input * kPrime2, 31) * kPrime1;
+}
+
+uint64_t MergeRound(uint64_t hash, uint64_t accumulator) {
+  return (hash ^ Round(0, accumulator)) * kPrime1 + kPrime4;
+}
+
+bool IsOff(const char *value) {
+  return value && (std::strcmp(value, "off") == 0 ||
+                   std::strcmp(value, "0") == 0);
+}
+
+const char *GetEnvironment(const char *name) {
+  const char *value = std::getenv(name);
+  return value ? value : "";
+}
+}  // namespace
+
+std::mutex ResultCache::mutex_;
+std::map<ResultKey, ResultCache::Entry> ResultCache::entries_;
+std::list<ResultKey> ResultCache::order_;
+std::size_t ResultCache::used_ = 0;
+std::size_t ResultCache::limit_ = (std::size_t)256 << 20;
+std::string ResultCache::directory_ = GetEnvironment("S21_RESULT_CACHE_DIR");
+bool ResultCache::bypass_ = IsOff(std::getenv("S21_RESULT_CACHE"));
+std::atomic<int> ResultCache::scoped_bypasses_{0};
+ResultCacheStats ResultCache::stats_;
+
+std::string ResultKey::ToString() const {
+  std::ostringstream text;
+  text << std::hex << std::setfill('0') << std::setw(16) << high
+       << std::setw(16) << low;
+  return text.str();
+}
+
+//  Four lanes of 8 bytes per 32-byte stripe, then the tail
+uint64_t ResultCache::Hash(const void *data, std::size_t bytes,
+                           uint64_t seed) {
+  const auto *position = static_cast<const unsigned char *>(data);
+  const unsigned char *end = position + bytes;
+  uint64_t hash;
+  if (bytes >= 32) {
+    uint64_t lanes[4] = {seed + kPrime1 + kPrime2, seed + kPrime2, seed,
+                         seed - kPrime1};
+    for (; position + 32 <= end; position += 32)
+      for (int lane = 0; lane < 4; ++lane)
+        lanes[lane] = Round(lanes[lane], Read<uint64_t>(position + 8 * lane));
+    hash = Rotate(lanes[0], 1) + Rotate(lanes[1], 7) + Rotate(lanes[2], 12) +
+           Rotate(lanes[3], 18);
+    for (uint64_t lane : lanes) hash = MergeRound(hash, lane);
+  } else {
+    hash = seed + kPrime5;
+  }
+  hash += bytes;
+  for (; position + 8 <= end; position += 8)
+    hash = Rotate(hash ^ Round(0, Read<uint64_t>(position)), 27) * kPrime1 +
+           kPrime4;
+  if (position + 4 <= end) {
+    hash = Rotate(hash ^ Read<uint32_t>(position) * kPrime1, 23) * kPrime2 +
+           kPrime3;
+    position += 4;
+  }
+  for (; position < end; ++position)
+    hash = Rotate(hash ^ *position * kPrime5, 11) * kPrime1;
+  hash ^= hash >> 33;
+  hash *= kPrime2;
+  hash ^= hash >> 29;
+  hash *= kPrime3;
+  hash ^= hash >> 32;
+  return hash;
+}
+
+//  Shapes are hashed along with the data, a 2 x 6 and a 3 x 4 matrix
+//  with the same values get different keys
+ResultKey ResultCache::MakeKey(
+    const std::string &algorithm,
+    const std::vector<const Matrix<double> *> &operands,
+    const std::string &parameters) {
+  std::string name = algorithm + '\0' + parameters;
+  uint64_t hashes[2];
+  uint64_t seeds[2] = {0, kSecondSeed};
+  for (int i = 0; i < 2; ++i) {
+    uint64_t hash = Hash(name.data(), name.size(), seeds[i]);
+    for (const Matrix<double> *operand : operands) {
+      int32_t shape[2] = {operand->GetRows(), operand->GetCols()};
+      hash = Hash(shape, sizeof(shape), hash);
+      hash = Hash(operand->GetData(),
+                  sizeof(double) * (std::size_t)shape[0] * shape[1], hash);
+    }
+    hashes[i] = hash;
+  }
+  return {hashes[0], hashes[1]};
+}
+
+ResultKey ResultCache::MakeKey(const std::string &algorithm,
+                               const SparseMatrix<double> &matrix,
+                               const std::vector<double> &vector,
+                               const std::string &parameters) {
+  std::string name = algorithm + '\0' + "sparse" + '\0' + parameters;
+  uint64_t hashes[2];
+  uint64_t seeds[2] = {0, kSecondSeed};
+  for (int i = 0; i < 2; ++i) {
+    uint64_t hash = Hash(name.data(), name.size(), seeds[i]);
+    int32_t shape[3] = {matrix.GetRows(), matrix.GetCols(),
+                        (int32_t)vector.size()};
+    hash = Hash(shape, sizeof(shape), hash);
+    hash = Hash(matrix.GetRowStart().data(),
+                sizeof(int) * matrix.GetRowStart().size(), hash);
+    hash = Hash(matrix.GetColIndex().data(),
+                sizeof(int) * matrix.GetColIndex().size(), hash);
+    hash = Hash(matrix.GetValues().data(),
+                sizeof(double) * matrix.GetValues().size(), hash);
+    hashes[i] = Hash(vector.data(), sizeof(double) * vector.size(), hash);
+  }
+  return {hashes[0], hashes[1]};
+}
+
+bool ResultCache::Lookup(const ResultKey &key, Matrix<double> &result) {
+  if (IsBypassed()) return false;
+  std::unique_lock<std::mutex> lock(mutex_);
+  auto found = entries_.find(key);
+  if (found != entries_.end()) {
+    order_.splice(order_.begin(), order_, found->second.position);
+    ++stats_.memory_hits;
+    result = found->second.value;
+    return true;
+  }
+  std::string path = DiskPath_(key);
+  lock.unlock();
+  if (!path.empty()) {
+    MatrixParser parser;
+    Matrix<double> loaded = parser.LoadBinaryMatrixFromFile(path);
+    if (!parser.GetError()) {
+      lock.lock();
+      ++stats_.disk_hits;
+      Insert_(key, loaded);
+      result = std::move(loaded);
+      return true;
+    }
+  }
+  lock.lock();
+  ++stats_.misses;
+  return false;
+}
+
+bool ResultCache::Lookup(const ResultKey &key, std::vector<double> &result) {
+  Matrix<double> row;
+  if (!Lookup(key, row) || row.GetRows() != 1) return false;
+  result.assign(row.GetData(), row.GetData() + row.GetCols());
+  return true;
+}
+
+//  The file is written outside the lock, a failed write only costs the
+//  disk tier this entry
+void ResultCache::Store(const ResultKey &key, const Matrix<double> &result) {
+  if (IsBypassed() || result.GetRows() == 0) return;
+  std::string path;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++stats_.stores;
+    Insert_(key, result);
+    if (!directory_.empty()) {
+      mkdir(directory_.c_str(), 0755);
+      path = DiskPath_(key);
+    }
+  }
+  if (!path.empty()) MatrixParser::SaveBinaryMatrixToFile(result, path);
+}
+
+void ResultCache::Store(const ResultKey &key,
+                        const std::vector<double> &result) {
+  if (IsBypassed() || result.empty()) return;
+  Matrix<double> row(1, (int)result.size());
+  std::copy(result.begin(), result.end(), row.GetData());
+  Store(key, row);
+}
+
+void ResultCache::SetMemoryLimit(std::size_t bytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  limit_ = bytes;
+  Insert_(ResultKey(), Matrix<double>());
+}
+
+void ResultCache::SetDiskDirectory(const std::string &path) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  directory_ = path;
+}
+
+std::string ResultCache::GetDiskDirectory() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return directory_;
+}
+
+void ResultCache::SetBypass(bool bypass) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  bypass_ = bypass;
+}
+
+bool ResultCache::IsBypassed() {
+  if (scoped_bypasses_ > 0) return true;
+  std::lock_guard<std::mutex> lock(mutex_);
+  return bypass_;
+}
+
+ResultCacheStats ResultCache::GetStats() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ResultCacheStats stats = stats_;
+  stats.entries = entries_.size();
+  stats.bytes = used_;
+  return stats;
+}
+
+void ResultCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.clear();
+  order_.clear();
+  used_ = 0;
+  stats_ = ResultCacheStats();
+}
+
+std::string ResultCache::DiskPath_(const ResultKey &key) {
+  if (directory_.empty()) return "";
+  return directory_ + "/" + key.ToString() + ".s21m";
+}
+
+//  An empty value only trims the tier to the limit, a limit of 0 leaves
+//  only the disk tier
+void ResultCache::Insert_(const ResultKey &key, const Matrix<double> &value) {
+  if (value.GetRows() > 0) {
+    auto found = entries_.find(key);
+    if (found != entries_.end()) {
+      used_ -= found->second.bytes;
+      order_.erase(found->second.position);
+      entries_.erase(found);
+    }
+    Entry &entry = entries_[key];
+    entry.value = value;
+    entry.bytes =
+        sizeof(double) * (std::size_t)value.GetRows() * value.GetCols();
+    entry.position = order_.insert(order_.begin(), key);
+    used_ += entry.bytes;
+  }
+  while (used_ > limit_ && !order_.empty()) {
+    auto oldest = entries_.find(order_.back());
+    used_ -= oldest->second.bytes;
+    entries_.erase(oldest);
+    order_.pop_back();
+    ++stats_.evictions;
+  }
+}
+}  // namespace s21
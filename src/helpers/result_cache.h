@@ -0,0 +1,103 @@
+#ifndef SRC_HELPERS_RESULT_CACHE_H
+#define SRC_HELPERS_RESULT_CACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "matrix.h"
+#include "sparse_matrix.h"
+
+namespace s21 {
+
+//  128 bits from two XXH64 passes with different seeds, so an accidental
+//  collision that hands back a wrong result is out of the question
+struct ResultKey {
+  uint64_t low = 0, high = 0;
+
+  std::string ToString() const;  //  32 hex digits
+  bool operator<(const ResultKey &other) const {
+    return low != other.low ? low < other.low : high < other.high;
+  }
+  bool operator==(const ResultKey &other) const {
+    return low == other.low && high == other.high;
+  }
+};
+
+struct ResultCacheStats {
+  long long memory_hits = 0, disk_hits = 0, misses = 0;
+  long long stores = 0, evictions = 0;
+  std::size_t entries = 0, bytes = 0;
+};
+
+//  Results of earlier computations keyed by the contents of their operands
+//  and the parameters that change the answer. The first tier is an LRU in
+//  memory bounded by bytes, the optional second one a directory of files
+//  in MatrixParser's binary format named after the key, shared between
+//  runs. A disk hit is promoted to memory. Vectors are kept as 1 x n
+//  matrices.
+//
+//  Benchmarks must measure the computation itself and take a ScopedBypass,
+//  which also $S21_RESULT_CACHE=off sets for the whole process.
+class ResultCache {
+ public:
+  //  XXH64 of the bytes in host order
+  static uint64_t Hash(const void *data, std::size_t bytes, uint64_t seed);
+  static ResultKey MakeKey(const std::string &algorithm,
+                           const std::vector<const Matrix<double> *> &operands,
+                           const std::string &parameters = "");
+  //  A CSR matrix and a vector, e.g. a sparse system and its right-hand side
+  static ResultKey MakeKey(const std::string &algorithm,
+                           const SparseMatrix<double> &matrix,
+                           const std::vector<double> &vector,
+                           const std::string &parameters = "");
+
+  static bool Lookup(const ResultKey &key, Matrix<double> &result);
+  static bool Lookup(const ResultKey &key, std::vector<double> &result);
+  static void Store(const ResultKey &key, const Matrix<double> &result);
+  static void Store(const ResultKey &key, const std::vector<double> &result);
+
+  static void SetMemoryLimit(std::size_t bytes);
+  //  Default is $S21_RESULT_CACHE_DIR, empty keeps results in memory only.
+  //  The directory is created on the first store.
+  static void SetDiskDirectory(const std::string &path);
+  static std::string GetDiskDirectory();
+  static void SetBypass(bool bypass);
+  static bool IsBypassed();
+  static ResultCacheStats GetStats();
+  static void Clear();  //  memory tier and statistics, files stay
+
+  class ScopedBypass {
+   public:
+    ScopedBypass() { ++scoped_bypasses_; }
+    ~ScopedBypass() { --scoped_bypasses_; }
+    ScopedBypass(const ScopedBypass &) = delete;
+    ScopedBypass &operator=(const ScopedBypass &) = delete;
+  };
+
+ private:
+  struct Entry {
+    Matrix<double> value;
+    std::size_t bytes = 0;
+    std::list<ResultKey>::iterator position;
+  };
+
+  static std::mutex mutex_;
+  static std::map<ResultKey, Entry> entries_;
+  static std::list<ResultKey> order_;  //  most recently used first
+  static std::size_t used_, limit_;
+  static std::string directory_;
+  static bool bypass_;
+  static std::atomic<int> scoped_bypasses_;
+  static ResultCacheStats stats_;
+
+  static std::string DiskPath_(const ResultKey &key);
+  static void Insert_(const ResultKey &key, const Matrix<double> &value);
+};
+}  // namespace s21
+
+#endif  // SRC_HELPERS_RESULT_CACHE_H
@@ -0,0 +1,171 @@
+#include "result_writer.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <climits>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+#include "barrier.h"
+#include "matrix_parser.h"
+#include "topology.h"
+
+namespace s21 {
+ResultWriter::ResultWriter(int fd, ResultFormat format)
+    : fd_(fd), format_(format) {}
+
+void ResultWriter::SetPrecision(int precision) {
+  precision_ = std::clamp(precision, 0, 17);
+}
+
+void ResultWriter::SetThreads(int number_of_thread) {
+  threads_ = std::max(number_of_thread, 0);
+}
+
+void ResultWriter::SetChunkBytes(std::size_t bytes) {
+  chunk_bytes_ = std::max<std::size_t>(bytes, kMaxValueChars);
+}
+
+template <class T>
+char *ResultWriter::FormatValues_(const T *values, int count,
+                                  char *out) const {
+  char *last = out + (std::size_t)count * kMaxValueChars;
+  for (int i = 0; i < count; ++i) {
+    if constexpr (std::is_floating_point_v<T>) {
+      out = precision_ > 0 ? std::to_chars(out, last, values[i],
+                                           std::chars_format::general,
+                                           precision_)
+                                 .ptr
+                           : std::to_chars(out, last, values[i]).ptr;
+    } else {
+      out = std::to_chars(out, last, values[i]).ptr;
+    }
+    *out++ = separator_;
+  }
+  return out;
+}
+
+void ResultWriter::FormatRows_(const Matrix<double> &matrix, int start,
+                               int end, std::string &buffer) const {
+  int cols = matrix.GetCols();
+  buffer.resize((std::size_t)(end - start) * (cols * kMaxValueChars + 1));
+  char *out = &buffer[0];
+  for (int row = start; row < end; ++row) {
+    out = FormatValues_(matrix.GetRow(row), cols, out);
+    *out++ = '\n';
+  }
+  buffer.resize(out - buffer.data());
+}
+
+//  Blocks are dealt out in waves of one block per thread. After a wave
+//  the caller's thread writes every buffer of it with one writev while
+//  the others wait at the barrier, then the buffers are reused.
+bool ResultWriter::WriteMatrix(const Matrix<double> &matrix) {
+  int rows = matrix.GetRows(), cols = matrix.GetCols();
+  if (format_ == BINARY_FORMAT)
+    return WriteBinary_(rows, cols, matrix.GetData());
+  if (rows == 0) return true;
+  int rows_per_block = (int)std::max<std::size_t>(
+      1, chunk_bytes_ / ((std::size_t)cols * kMaxValueChars + 1));
+  int blocks = (rows + rows_per_block - 1) / rows_per_block;
+  int threads = threads_ > 0 ? threads_ : Topology::Get().GetMaxThreads();
+  threads = std::min(threads, blocks);
+  std::vector<std::string> buffers(threads);
+  std::vector<iovec> parts;
+  Barrier barrier(threads);
+  bool written = true;
+
+  auto run = [&](int thread_id) {
+    for (int wave = 0; wave < blocks; wave += threads) {
+      int block = wave + thread_id;
+      if (block < blocks)
+        FormatRows_(matrix, block * rows_per_block,
+                    std::min(rows, (block + 1) * rows_per_block),
+                    buffers[thread_id]);
+      else
+        buffers[thread_id].clear();
+      barrier.Wait();
+      if (thread_id == 0 && written) {
+        parts.clear();
+        for (std::string &buffer : buffers)
+          if (!buffer.empty()) parts.push_back({&buffer[0], buffer.size()});
+        written = WriteAll_(parts);
+      }
+      barrier.Wait();
+    }
+  };
+  std::vector<std::thread> workers;
+  for (int i = 1; i < threads; ++i) workers.emplace_back(run, i);
+  run(0);
+  for (std::thread &worker : workers) worker.join();
+  return written;
+}
+
+bool ResultWriter::WriteVector(const std::vector<double> &values) {
+  if (format_ == BINARY_FORMAT)
+    return WriteBinary_(values.empty() ? 0 : 1, (int)values.size(),
+                        values.data());
+  std::string buffer(values.size() * kMaxValueChars, '\0');
+  char *out = FormatValues_(values.data(), (int)values.size(), &buffer[0]);
+  buffer.resize(out - buffer.data());
+  return WriteText(buffer);
+}
+
+//  Binary output has no integer matrix, the values are widened
+bool ResultWriter::WriteVector(const std::vector<int> &values) {
+  if (format_ == BINARY_FORMAT)
+    return WriteVector(std::vector<double>(values.begin(), values.end()));
+  std::string buffer(values.size() * kMaxValueChars, '\0');
+  char *out = FormatValues_(values.data(), (int)values.size(), &buffer[0]);
+  buffer.resize(out - buffer.data());
+  return WriteText(buffer);
+}
+
+bool ResultWriter::WriteText(const std::string &text) {
+  std::vector<iovec> parts{
+      {const_cast<char *>(text.data()), text.size()}};
+  return WriteAll_(parts);
+}
+
+//  Same header as MatrixParser::SaveBinaryMatrixToFile
+bool ResultWriter::WriteBinary_(int rows, int cols, const double *data) {
+  char header[16];
+  int32_t shape[2] = {rows, cols};
+  std::memcpy(header, MatrixParser::kBinaryMagic, 4);
+  std::memcpy(header + 4, &MatrixParser::kBinaryVersion, 4);
+  std::memcpy(header + 8, shape, sizeof(shape));
+  std::vector<iovec> parts{
+      {header, sizeof(header)},
+      {const_cast<double *>(data), sizeof(double) * (std::size_t)rows * cols}};
+  return WriteAll_(parts);
+}
+
+//  Retried on EINTR and short writes, at most IOV_MAX parts per call
+bool ResultWriter::WriteAll_(std::vector<iovec> &parts) {
+  if (fd_ == STDOUT_FILENO) std::cout.flush();
+  std::size_t first = 0;
+  while (first < parts.size()) {
+    if (parts[first].iov_len == 0) {
+      ++first;
+      continue;
+    }
+    int count = (int)std::min<std::size_t>(parts.size() - first, IOV_MAX);
+    ssize_t done = writev(fd_, &parts[first], count);
+    if (done < 0 && errno == EINTR) continue;
+    if (done < 0) {
+      error_ = std::strerror(errno);
+      return false;
+    }
+    for (; first < parts.size() && (std::size_t)done >= parts[first].iov_len;
+         ++first)
+      done -= (ssize_t)parts[first].iov_len;
+    if (first < parts.size()) {
+      parts[first].iov_base = static_cast<char *>(parts[first].iov_base) + done;
+      parts[first].iov_len -= (std::size_t)done;
+    }
+  }
+  return true;
+}
+}  // namespace s21
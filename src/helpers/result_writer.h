@@ -0,0 +1,67 @@
+#ifndef SRC_HELPERS_RESULT_WRITER_H
+#define SRC_HELPERS_RESULT_WRITER_H
+
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "matrix.h"
+
+namespace s21 {
+
+enum ResultFormat {
+  TEXT_FORMAT,   //  values end with a separator, rows with '\n'
+  BINARY_FORMAT  //  MatrixParser's binary format, vectors as 1 x n
+};
+
+//  Writes results straight to a file descriptor. Text is formatted with
+//  std::to_chars into one buffer per block of rows, the blocks of a wave
+//  are formatted by one thread each and leave in a single writev, so a
+//  large matrix costs a few system calls instead of a stream insertion
+//  per value. Binary output sends the matrix memory as it is. Whatever
+//  std::cout still buffers is flushed first when writing to stdout.
+class ResultWriter {
+ public:
+  explicit ResultWriter(int fd = STDOUT_FILENO,
+                        ResultFormat format = TEXT_FORMAT);
+  ~ResultWriter() = default;
+
+  //  0 formats doubles in the shortest form that reads back exactly,
+  //  otherwise like printf("%.*g"), 6 matches the default of std::cout
+  void SetPrecision(int precision);
+  void SetSeparator(char separator) { separator_ = separator; }
+  void SetThreads(int number_of_thread);  //  0 takes GetMaxThreads()
+  void SetChunkBytes(std::size_t bytes);  //  text per block, about
+
+  bool WriteMatrix(const Matrix<double> &matrix);
+  bool WriteVector(const std::vector<double> &values);
+  bool WriteVector(const std::vector<int> &values);
+  bool WriteText(const std::string &text);  //  as is, also in binary mode
+  const std::string &GetError() const { return error_; }
+
+ private:
+  //  Longest value to_chars can produce for precision <= 17, with sign,
+  //  exponent and the separator
+  static constexpr int kMaxValueChars = 32;
+
+  int fd_;
+  ResultFormat format_;
+  int precision_ = 0;
+  char separator_ = '\t';
+  int threads_ = 0;
+  std::size_t chunk_bytes_ = (std::size_t)1 << 20;
+  std::string error_;
+
+  template <class T>
+  char *FormatValues_(const T *values, int count, char *out) const;
+  void FormatRows_(const Matrix<double> &matrix, int start, int end,
+                   std::string &buffer) const;
+  bool WriteBinary_(int rows, int cols, const double *data);
+  bool WriteAll_(std::vector<iovec> &parts);
+};
+}  // namespace s21
+
+#endif  // SRC_HELPERS_RESULT_WRITER_H
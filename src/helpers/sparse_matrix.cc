@@ -0,0 +1,103 @@
+#include "sparse_matrix.h"
+
+#include <algorithm>
+
+namespace s21 {
+
+template <typename T>
+SparseMatrix<T>::SparseMatrix(int rows, int cols) : rows_(rows), cols_(cols) {
+  if (rows_ < 0 || cols_ < 0) error_ = true;
+  if (!error_) row_start_.reserve(rows_ + 1);
+}
+
+//  cols allows to take only the leading columns, e.g. the coefficients of
+//  an augmented n x (n + 1) system
+template <typename T>
+SparseMatrix<T>::SparseMatrix(Matrix<T> &dense, int cols)
+    : SparseMatrix(dense.GetRows(), cols < 0 ? dense.GetCols() : cols) {
+  if (cols_ > dense.GetCols()) error_ = true;
+  std::vector<std::pair<int, T>> entries;
+  for (int i = 0; i < rows_ && !error_; i++) {
+    entries.clear();
+    for (int j = 0; j < cols_; j++)
+      if (dense(i, j) != T()) entries.push_back({j, dense(i, j)});
+    AppendRow(entries);
+  }
+}
+
+template <typename T>
+double SparseMatrix<T>::GetDensity() const {
+  if (rows_ == 0 || cols_ == 0) return 0;
+  return (double)values_.size() / ((double)rows_ * cols_);
+}
+
+template <typename T>
+void SparseMatrix<T>::AppendRow(const std::vector<std::pair<int, T>> &entries) {
+  if (filled_rows_ >= rows_) throw std::range_error("Too many rows");
+  for (const auto &entry : entries) {
+    if (entry.first < 0 || entry.first >= cols_)
+      throw std::range_error("Incorrect matrix size_");
+    col_index_.push_back(entry.first);
+    values_.push_back(entry.second);
+  }
+  row_start_.push_back((int)values_.size());
+  filled_rows_++;
+}
+
+template <typename T>
+T SparseMatrix<T>::operator()(int row, int col) const {
+  if (row >= filled_rows_ || col >= cols_ || row < 0 || col < 0)
+    throw std::range_error("Incorrect matrix size_");
+  auto begin = col_index_.begin() + row_start_[row];
+  auto end = col_index_.begin() + row_start_[row + 1];
+  auto it = std::lower_bound(begin, end, col);
+  return (it != end && *it == col) ? values_[it - col_index_.begin()] : T();
+}
+
+template <typename T>
+void SparseMatrix<T>::MulVector(const std::vector<T> &vector,
+                                std::vector<T> &result) const {
+  if ((int)vector.size() != cols_) throw std::range_error("Error");
+  result.assign(rows_, T());
+  for (int i = 0; i < filled_rows_; i++) {
+    T sum = T();
+    for (int k = row_start_[i]; k < row_start_[i + 1]; k++)
+      sum += values_[k] * vector[col_index_[k]];
+    result[i] = sum;
+  }
+}
+
+template <typename T>
+SparseMatrix<T> SparseMatrix<T>::Transpose() const {
+  SparseMatrix<T> result(cols_, rows_);
+  std::vector<int> start(cols_ + 1, 0);
+  for (int col : col_index_) start[col + 1]++;
+  for (int j = 0; j < cols_; j++) start[j + 1] += start[j];
+  result.row_start_ = start;
+  result.col_index_.resize(values_.size());
+  result.values_.resize(values_.size());
+  for (int i = 0; i < filled_rows_; i++) {
+    for (int k = row_start_[i]; k < row_start_[i + 1]; k++) {
+      int position = start[col_index_[k]]++;
+      result.col_index_[position] = i;
+      result.values_[position] = values_[k];
+    }
+  }
+  result.filled_rows_ = cols_;
+  return result;
+}
+
+template <typename T>
+Matrix<T> SparseMatrix<T>::ToMatrix() const {
+  Matrix<T> result(rows_, cols_);
+  for (int i = 0; i < filled_rows_; i++)
+    for (int k = row_start_[i]; k < row_start_[i + 1]; k++)
+      result(i, col_index_[k]) = values_[k];
+  return result;
+}
+
+}  // namespace s21
+
+template class s21::SparseMatrix<double>;
+template class s21::SparseMatrix<float>;
+template class s21::SparseMatrix<int>;
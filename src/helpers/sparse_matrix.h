@@ -0,0 +1,49 @@
+#ifndef SRC_HELPERS_SPARSE_MATRIX_H
+#define SRC_HELPERS_SPARSE_MATRIX_H
+
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "matrix.h"
+
+namespace s21 {
+//  Compressed sparse row storage. The transpose of a CSR matrix is the CSC
+//  form of the original one, so Transpose() doubles as the CSC conversion.
+template <class T>
+class SparseMatrix {
+ public:
+  SparseMatrix() = default;
+  SparseMatrix(int rows, int cols);
+  explicit SparseMatrix(Matrix<T> &dense, int cols = -1);
+  ~SparseMatrix() = default;
+
+  [[nodiscard]] int GetRows() const { return rows_; }
+  [[nodiscard]] int GetCols() const { return cols_; }
+  [[nodiscard]] int GetNonZeros() const { return (int)values_.size(); }
+  [[nodiscard]] double GetDensity() const;
+  bool GetError() { return error_; }
+
+  //  Rows are filled in order, entries of a row by increasing column
+  void AppendRow(const std::vector<std::pair<int, T>> &entries);
+
+  const std::vector<int> &GetRowStart() const { return row_start_; }
+  const std::vector<int> &GetColIndex() const { return col_index_; }
+  const std::vector<T> &GetValues() const { return values_; }
+
+  T operator()(int row, int col) const;
+  void MulVector(const std::vector<T> &vector, std::vector<T> &result) const;
+  SparseMatrix<T> Transpose() const;
+  Matrix<T> ToMatrix() const;
+
+ private:
+  int rows_{}, cols_{};
+  int filled_rows_{};
+  std::vector<int> row_start_{0};
+  std::vector<int> col_index_;
+  std::vector<T> values_;
+  bool error_{false};
+};
+}  // namespace s21
+
+#endif  // SRC_HELPERS_SPARSE_MATRIX_H
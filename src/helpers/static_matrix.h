@@ -0,0 +1,136 @@
+#ifndef SRC_HELPERS_STATIC_MATRIX_H
+#define SRC_HELPERS_STATIC_MATRIX_H
+
+#include <array>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+
+#include "matrix.h"
+
+namespace s21 {
+//  Matrix with dimensions fixed at compile time and the elements stored
+//  inline, row-major, so small operands need no heap allocation. Unlike
+//  Matrix<T> every instantiation is generated from this header, the
+//  multiplication and the elimination are unrolled for the exact size.
+template <class T, int R, int C>
+class StaticMatrix {
+  static_assert(R > 0 && C > 0, "StaticMatrix dimensions must be positive");
+
+ public:
+  static constexpr int kRows = R;
+  static constexpr int kCols = C;
+
+  constexpr StaticMatrix() = default;
+  StaticMatrix(std::initializer_list<T> const &items) {
+    if ((int)items.size() != R * C)
+      throw std::range_error("Incorrect matrix size_");
+    int index = 0;
+    for (const T &item : items) data_[index++] = item;
+  }
+  explicit StaticMatrix(const Matrix<T> &matrix) {
+    if (matrix.GetRows() != R || matrix.GetCols() != C)
+      throw std::range_error("Incorrect matrix size_");
+    for (int i = 0; i < R; i++) {
+      const T *row = matrix.GetRow(i);
+      for (int j = 0; j < C; j++) data_[i * C + j] = row[j];
+    }
+  }
+
+  [[nodiscard]] constexpr int GetRows() const { return R; }
+  [[nodiscard]] constexpr int GetCols() const { return C; }
+
+  Matrix<T> ToMatrix() const {
+    Matrix<T> result(R, C);
+    for (int i = 0; i < R; i++) {
+      T *row = result.GetRow(i);
+      for (int j = 0; j < C; j++) row[j] = data_[i * C + j];
+    }
+    return result;
+  }
+
+  void FillMatrix(T value) { data_.fill(value); }
+
+  constexpr T &operator()(int row, int col) {
+    if (row >= R || col >= C || row < 0 || col < 0)
+      throw std::range_error("Incorrect matrix size_");
+    return data_[row * C + col];
+  }
+  constexpr const T &operator()(int row, int col) const {
+    if (row >= R || col >= C || row < 0 || col < 0)
+      throw std::range_error("Incorrect matrix size_");
+    return data_[row * C + col];
+  }
+
+  bool operator==(const StaticMatrix &other) const {
+    return data_ == other.data_;
+  }
+
+  template <int K>
+  StaticMatrix<T, R, K> operator*(const StaticMatrix<T, C, K> &other) const {
+    StaticMatrix<T, R, K> result;
+    MulElements_(other, result, std::make_index_sequence<R * K>{});
+    return result;
+  }
+
+  //  Only for augmented R x (R + 1) systems. Same elimination as
+  //  GaussAlgorithm without pivoting, false is returned on a zero pivot.
+  bool Solve(std::array<T, R> &result) const {
+    static_assert(C == R + 1, "Solve needs an augmented R x (R + 1) matrix");
+    std::array<T, R * C> work = data_;
+    if (!Eliminate_<0>(work)) return false;
+    Substitute_<R - 1>(work, result);
+    return true;
+  }
+
+ private:
+  template <class, int, int>
+  friend class StaticMatrix;
+
+  std::array<T, R * C> data_{};
+
+  template <int K, std::size_t... E>
+  void MulElements_(const StaticMatrix<T, C, K> &other,
+                    StaticMatrix<T, R, K> &result,
+                    std::index_sequence<E...>) const {
+    ((result.data_[E] = Dot_<K, E / K, E % K>(
+          other, std::make_index_sequence<C>{})),
+     ...);
+  }
+
+  template <int K, int kRow, int kCol, std::size_t... I>
+  T Dot_(const StaticMatrix<T, C, K> &other, std::index_sequence<I...>) const {
+    return ((data_[kRow * C + I] * other.data_[I * K + kCol]) + ...);
+  }
+
+  template <int kPivot>
+  static bool Eliminate_(std::array<T, R * C> &work) {
+    if constexpr (kPivot < R) {
+      T pivot = work[kPivot * C + kPivot];
+      if (pivot == T()) return false;
+      for (int j = kPivot; j < C; j++) work[kPivot * C + j] /= pivot;
+      for (int i = kPivot + 1; i < R; i++) {
+        T factor = work[i * C + kPivot];
+        for (int j = kPivot; j < C; j++)
+          work[i * C + j] -= factor * work[kPivot * C + j];
+      }
+      return Eliminate_<kPivot + 1>(work);
+    } else {
+      return true;
+    }
+  }
+
+  template <int kRow>
+  static void Substitute_(const std::array<T, R * C> &work,
+                          std::array<T, R> &result) {
+    if constexpr (kRow >= 0) {
+      T sum = work[kRow * C + R];
+      for (int j = kRow + 1; j < R; j++) sum -= work[kRow * C + j] * result[j];
+      result[kRow] = sum;
+      Substitute_<kRow - 1>(work, result);
+    }
+  }
+};
+}  // namespace s21
+
+#endif  // SRC_HELPERS_STATIC_MATRIX_H
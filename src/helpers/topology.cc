@@ -0,0 +1,221 @@
+#include "topology.h"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <tuple>
+#include <utility>
+
+namespace s21 {
+std::mutex Topology::mutex_;
+AffinityPolicy Topology::policy_ = Topology::GetEnvironmentPolicy_();
+
+const Topology &Topology::Get() {
+  static const Topology topology;
+  return topology;
+}
+
+void Topology::SetPolicy(AffinityPolicy policy) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  policy_ = policy;
+}
+
+AffinityPolicy Topology::GetPolicy() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return policy_;
+}
+
+Topology::Topology() {
+  const std::string root = "/sys/devices/system/cpu/";
+  std::vector<int> online = ReadList_(root + "online");
+  if (online.empty()) {
+    int count = (int)std::thread::hardware_concurrency();
+    for (int i = 0; i < (count > 0 ? count : 1); ++i) online.push_back(i);
+  }
+#ifdef __linux__
+  //  Mask of the main thread, so a cpuset or taskset shrinks the topology
+  //  but a pinned worker that happens to build it first does not
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  if (sched_getaffinity(getpid(), sizeof(allowed), &allowed) == 0) {
+    std::vector<int> usable;
+    for (int cpu : online)
+      if (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed)) usable.push_back(cpu);
+    if (!usable.empty()) online = usable;
+  }
+#endif
+  for (int cpu : online) {
+    std::string path = root + "cpu" + std::to_string(cpu) + "/topology/";
+    CpuLocation location;
+    location.cpu = cpu;
+    location.core = ReadNumber_(path + "core_id", cpu);
+    location.package = ReadNumber_(path + "physical_package_id", 0);
+    cpus_.push_back(location);
+  }
+  std::sort(cpus_.begin(), cpus_.end(),
+            [](const CpuLocation &a, const CpuLocation &b) {
+              return std::make_tuple(a.package, a.core, a.cpu) <
+                     std::make_tuple(b.package, b.core, b.cpu);
+            });
+  std::set<std::pair<int, int>> cores;
+  std::set<int> packages;
+  for (const CpuLocation &location : cpus_) {
+    cores.emplace(location.package, location.core);
+    packages.insert(location.package);
+  }
+  cores_ = (int)cores.size();
+  packages_ = (int)packages.size();
+}
+
+int Topology::GetMaxThreads() const { return GetMaxThreads(GetPolicy()); }
+
+int Topology::GetMaxThreads(AffinityPolicy policy) const {
+  return policy == PHYSICAL_CORES_AFFINITY ? cores_ : GetCpuCount();
+}
+
+std::vector<int> Topology::Placement(int number_of_thread) const {
+  return Placement(number_of_thread, GetPolicy());
+}
+
+std::vector<int> Topology::Placement(int number_of_thread,
+                                     AffinityPolicy policy) const {
+  std::vector<int> placement(number_of_thread > 0 ? number_of_thread : 0, -1);
+  if (policy == NO_AFFINITY) return placement;
+  std::vector<int> order = Order_(policy);
+  for (size_t i = 0; i < placement.size(); ++i)
+    placement[i] = order[i % order.size()];
+  return placement;
+}
+
+//  cpus_ is already the compact order. Scatter deals the cores of every
+//  socket out in turn and only then comes back for their SMT siblings.
+std::vector<int> Topology::Order_(AffinityPolicy policy) const {
+  std::map<int, std::vector<std::vector<int>>> sockets;
+  for (size_t i = 0; i < cpus_.size(); ++i) {
+    auto &cores = sockets[cpus_[i].package];
+    if (i == 0 || cpus_[i].package != cpus_[i - 1].package ||
+        cpus_[i].core != cpus_[i - 1].core)
+      cores.emplace_back();
+    cores.back().push_back(cpus_[i].cpu);
+  }
+  std::vector<int> order;
+  if (policy == COMPACT_AFFINITY) {
+    for (const CpuLocation &location : cpus_) order.push_back(location.cpu);
+  } else if (policy == PHYSICAL_CORES_AFFINITY) {
+    for (auto &socket : sockets)
+      for (auto &core : socket.second) order.push_back(core.front());
+  } else {
+    size_t siblings = 0, cores = 0;
+    for (auto &socket : sockets) {
+      cores = std::max(cores, socket.second.size());
+      for (auto &core : socket.second)
+        siblings = std::max(siblings, core.size());
+    }
+    for (size_t s = 0; s < siblings; ++s)
+      for (size_t c = 0; c < cores; ++c)
+        for (auto &socket : sockets)
+          if (c < socket.second.size() && s < socket.second[c].size())
+            order.push_back(socket.second[c][s]);
+  }
+  return order;
+}
+
+const CpuLocation *Topology::Find_(int cpu) const {
+  for (const CpuLocation &location : cpus_)
+    if (location.cpu == cpu) return &location;
+  return nullptr;
+}
+
+//  "0:cpu0/core0/pkg0 1:cpu2/core1/pkg0 ..."
+std::string Topology::Describe(const std::vector<int> &placement) const {
+  std::ostringstream out;
+  for (size_t i = 0; i < placement.size(); ++i) {
+    if (i > 0) out << ' ';
+    out << i << ':';
+    const CpuLocation *location = Find_(placement[i]);
+    if (location == nullptr)
+      out << "any";
+    else
+      out << "cpu" << location->cpu << "/core" << location->core << "/pkg"
+          << location->package;
+  }
+  return out.str();
+}
+
+bool Topology::PinCurrentThread(int cpu) {
+#ifdef __linux__
+  if (cpu < 0 || cpu >= CPU_SETSIZE) return false;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+  (void)cpu;
+  return false;
+#endif
+}
+
+std::string Topology::GetPolicyName(AffinityPolicy policy) {
+  switch (policy) {
+    case COMPACT_AFFINITY:
+      return "compact";
+    case SCATTER_AFFINITY:
+      return "scatter";
+    case PHYSICAL_CORES_AFFINITY:
+      return "physical cores";
+    default:
+      return "none";
+  }
+}
+
+bool Topology::ParsePolicy(const std::string &name, AffinityPolicy &policy) {
+  const std::map<std::string, AffinityPolicy> names = {
+      {"none", NO_AFFINITY},
+      {"compact", COMPACT_AFFINITY},
+      {"scatter", SCATTER_AFFINITY},
+      {"cores", PHYSICAL_CORES_AFFINITY}};
+  auto found = names.find(name);
+  if (found == names.end()) return false;
+  policy = found->second;
+  return true;
+}
+
+AffinityPolicy Topology::GetEnvironmentPolicy_() {
+  const char *name = std::getenv("S21_AFFINITY");
+  AffinityPolicy policy = NO_AFFINITY;
+  if (name) ParsePolicy(name, policy);
+  return policy;
+}
+
+int Topology::ReadNumber_(const std::string &path, int fallback) {
+  std::ifstream file(path);
+  int value = fallback;
+  if (!(file >> value)) value = fallback;
+  return value;
+}
+
+//  Kernel cpu lists look like "0-3,8-11"
+std::vector<int> Topology::ReadList_(const std::string &path) {
+  std::vector<int> result;
+  std::ifstream file(path);
+  std::string item;
+  while (std::getline(file, item, ',')) {
+    int first = 0, last = 0;
+    char dash = 0;
+    std::istringstream range(item);
+    if (!(range >> first)) continue;
+    last = (range >> dash >> last && dash == '-') ? last : first;
+    for (int cpu = first; cpu <= last; ++cpu) result.push_back(cpu);
+  }
+  return result;
+}
+}  // namespace s21
@@ -0,0 +1,87 @@
+#ifndef SRC_HELPERS_TOPOLOGY_H
+#define SRC_HELPERS_TOPOLOGY_H
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace s21 {
+
+enum AffinityPolicy {
+  NO_AFFINITY,
+  COMPACT_AFFINITY,         //  fill the SMT siblings of a core first
+  SCATTER_AFFINITY,         //  spread over sockets, then cores, then siblings
+  PHYSICAL_CORES_AFFINITY,  //  one hardware thread per core
+};
+
+struct CpuLocation {
+  int cpu = 0;
+  int core = 0;
+  int package = 0;
+};
+
+//  Logical CPUs of the machine as listed in /sys/devices/system/cpu that
+//  the process may run on. Worker i of a parallel algorithm runs on
+//  Placement(n)[i] and also works on the i-th of the n bands of rows, so a
+//  placement keeps neighbouring bands on the same core or socket. Without
+//  sysfs every CPU is its own core. Nothing is pinned unless a policy is
+//  chosen with SetPolicy or $S21_AFFINITY: every placement starts at the
+//  first CPU of the order, so concurrent parallel calls would share it.
+class Topology {
+ public:
+  static const Topology &Get();
+  static void SetPolicy(AffinityPolicy policy);
+  static AffinityPolicy GetPolicy();
+
+  [[nodiscard]] int GetCpuCount() const { return (int)cpus_.size(); }
+  [[nodiscard]] int GetCoreCount() const { return cores_; }
+  [[nodiscard]] int GetPackageCount() const { return packages_; }
+  const std::vector<CpuLocation> &GetCpus() const { return cpus_; }
+
+  //  Most workers worth starting, one per core for PHYSICAL_CORES_AFFINITY
+  [[nodiscard]] int GetMaxThreads() const;
+  [[nodiscard]] int GetMaxThreads(AffinityPolicy policy) const;
+  //  CPU of every worker, -1 when it is not pinned. More workers than
+  //  CPUs in the order wrap around.
+  std::vector<int> Placement(int number_of_thread) const;
+  std::vector<int> Placement(int number_of_thread,
+                             AffinityPolicy policy) const;
+  std::string Describe(const std::vector<int> &placement) const;
+
+  //  Runs function(args...) like std::thread, but the new thread pins
+  //  itself to cpu before anything else, so the pages it touches first
+  //  are placed on the right node. cpu -1 leaves it unpinned.
+  template <class Function, class... Args>
+  static std::thread StartThread(int cpu, Function &&function,
+                                 Args &&...args) {
+    return std::thread(
+        [cpu](auto &&body, auto &&...values) {
+          PinCurrentThread(cpu);
+          std::invoke(std::move(body), std::move(values)...);
+        },
+        std::forward<Function>(function), std::forward<Args>(args)...);
+  }
+  static bool PinCurrentThread(int cpu);
+  static std::string GetPolicyName(AffinityPolicy policy);
+  //  "none", "compact", "scatter" or "cores", false for anything else
+  static bool ParsePolicy(const std::string &name, AffinityPolicy &policy);
+
+ private:
+  std::vector<CpuLocation> cpus_;  //  sorted by package, core and cpu
+  int cores_{1}, packages_{1};
+
+  static std::mutex mutex_;
+  static AffinityPolicy policy_;
+
+  Topology();
+  std::vector<int> Order_(AffinityPolicy policy) const;
+  const CpuLocation *Find_(int cpu) const;
+  static int ReadNumber_(const std::string &path, int fallback);
+  static std::vector<int> ReadList_(const std::string &path);
+  static AffinityPolicy GetEnvironmentPolicy_();
+};
+}  // namespace s21
+
+#endif  // SRC_HELPERS_TOPOLOGY_H
@@ -0,0 +1,134 @@
+#include "trace.h"
+
+#include <fstream>
+#include <memory>
+
+namespace s21 {
+namespace {
+using Clock = std::chrono::steady_clock;
+
+const Clock::time_point kTraceEpoch = Clock::now();
+
+std::mutex registry_mutex;
+std::vector<std::unique_ptr<TraceBuffer>> buffers;
+std::vector<TraceBuffer *> free_buffers;
+
+struct LocalBuffer {
+  TraceBuffer *buffer = nullptr;
+  ~LocalBuffer() {
+    if (buffer == nullptr) return;
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    free_buffers.push_back(buffer);
+  }
+};
+thread_local LocalBuffer local_buffer;
+}  // namespace
+
+TraceBuffer::TraceBuffer(int id, int capacity) : events_(capacity), id_(id) {}
+
+void TraceBuffer::Add(const TraceEvent &event) {
+  if (is_full_) dropped_++;
+  events_[next_] = event;
+  if (++next_ == events_.size()) {
+    next_ = 0;
+    is_full_ = true;
+  }
+}
+
+std::vector<TraceEvent> TraceBuffer::GetEvents() const {
+  std::vector<TraceEvent> result;
+  if (is_full_)
+    result.insert(result.end(), events_.begin() + next_, events_.end());
+  result.insert(result.end(), events_.begin(), events_.begin() + next_);
+  return result;
+}
+
+void TraceBuffer::Clear() {
+  next_ = 0;
+  is_full_ = false;
+  dropped_ = 0;
+}
+
+long long Trace::Now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() -
+                                                              kTraceEpoch)
+      .count();
+}
+
+TraceBuffer &Trace::Local_() {
+  if (local_buffer.buffer == nullptr) {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    if (!free_buffers.empty()) {
+      local_buffer.buffer = free_buffers.back();
+      free_buffers.pop_back();
+    } else {
+      buffers.push_back(
+          std::make_unique<TraceBuffer>((int)buffers.size(), kCapacity));
+      local_buffer.buffer = buffers.back().get();
+    }
+  }
+  return *local_buffer.buffer;
+}
+
+void Trace::Record(const char *name, const char *category, long long start,
+                   long long duration) {
+  TraceEvent event;
+  event.name = name;
+  event.category = category;
+  event.start = start;
+  event.duration = duration;
+  Local_().Add(event);
+}
+
+void Trace::Counter(const char *name, double value) {
+  TraceEvent event;
+  event.name = name;
+  event.category = "counter";
+  event.start = Now();
+  event.value = value;
+  event.phase = 'C';
+  Local_().Add(event);
+}
+
+//  Chrome trace event format, timestamps in microseconds. Every buffer is
+//  one thread lane, Perfetto opens the same file.
+bool Trace::WriteChromeJson(const std::string &path) {
+  std::ofstream file(path);
+  if (!file.is_open()) return false;
+  std::lock_guard<std::mutex> lock(registry_mutex);
+  file << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+  bool first = true;
+  for (const auto &buffer : buffers) {
+    file << (first ? "\n" : ",\n")
+         << "{\"ph\": \"M\", \"name\": \"thread_name\", \"pid\": 1, "
+            "\"tid\": "
+         << buffer->GetId() << ", \"args\": {\"name\": \"worker "
+         << buffer->GetId() << "\"}}";
+    first = false;
+    for (const TraceEvent &event : buffer->GetEvents()) {
+      file << ",\n{\"name\": \"" << event.name << "\", \"cat\": \""
+           << event.category << "\", \"ph\": \"" << event.phase
+           << "\", \"pid\": 1, \"tid\": " << buffer->GetId()
+           << ", \"ts\": " << event.start / 1000.0;
+      if (event.phase == 'X')
+        file << ", \"dur\": " << event.duration / 1000.0 << "}";
+      else
+        file << ", \"args\": {\"value\": " << event.value << "}}";
+    }
+  }
+  file << "\n]}\n";
+  return (bool)file;
+}
+
+void Trace::Clear() {
+  std::lock_guard<std::mutex> lock(registry_mutex);
+  for (const auto &buffer : buffers) buffer->Clear();
+}
+
+long long Trace::GetDropped() {
+  std::lock_guard<std::mutex> lock(registry_mutex);
+  long long dropped = 0;
+  for (const auto &buffer : buffers) dropped += buffer->GetDropped();
+  return dropped;
+}
+}  // namespace s21
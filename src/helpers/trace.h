@@ -0,0 +1,110 @@
+#ifndef SRC_HELPERS_TRACE_H
+#define SRC_HELPERS_TRACE_H
+
+//  Hot-path instrumentation. Built with -DS21_TRACE the macros below record
+//  into a ring buffer owned by the calling thread, without -DS21_TRACE they
+//  expand to nothing (S21_TRACE_LOCK to a plain lock()). Names must be
+//  string literals, only the pointer is stored.
+#ifdef S21_TRACE
+#define S21_TRACE_JOIN_(a, b) a##b
+#define S21_TRACE_NAME_(line) S21_TRACE_JOIN_(s21_trace_scope_, line)
+#define S21_TRACE_SCOPE(name) s21::ScopedTrace S21_TRACE_NAME_(__LINE__)(name)
+#define S21_TRACE_WAIT(name) \
+  s21::ScopedTrace S21_TRACE_NAME_(__LINE__)(name, "wait")
+#define S21_TRACE_COUNTER(name, value) s21::Trace::Counter(name, value)
+#define S21_TRACE_LOCK(mutex, name) s21::Trace::Lock(mutex, name)
+#else
+#define S21_TRACE_SCOPE(name) \
+  do {                        \
+  } while (0)
+#define S21_TRACE_WAIT(name) \
+  do {                       \
+  } while (0)
+#define S21_TRACE_COUNTER(name, value) \
+  do {                                 \
+  } while (0)
+#define S21_TRACE_LOCK(mutex, name) (mutex).lock()
+#endif
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace s21 {
+
+struct TraceEvent {
+  const char *name = nullptr;
+  const char *category = nullptr;
+  long long start = 0;     //  ns since the trace clock started
+  long long duration = 0;  //  ns, complete events only
+  double value = 0;        //  counters only
+  char phase = 'X';        //  'X' complete event, 'C' counter
+};
+
+//  Fixed-size ring, once full the oldest events are overwritten. Only the
+//  owning thread writes, so no locking is needed on the hot path.
+class TraceBuffer {
+ public:
+  TraceBuffer(int id, int capacity);
+  ~TraceBuffer() = default;
+
+  void Add(const TraceEvent &event);
+  std::vector<TraceEvent> GetEvents() const;  //  oldest first
+  [[nodiscard]] int GetId() const { return id_; }
+  [[nodiscard]] long long GetDropped() const { return dropped_; }
+  void Clear();
+
+ private:
+  std::vector<TraceEvent> events_;
+  size_t next_{};
+  bool is_full_{false};
+  long long dropped_{};
+  int id_;
+};
+
+//  A thread gets a buffer on its first event and gives it back when it
+//  exits, the next thread reuses it. Short-lived workers therefore share
+//  a few lanes in the timeline instead of growing memory without bound.
+class Trace {
+ public:
+  static constexpr int kCapacity = 1 << 15;
+
+  static long long Now();
+  static void Record(const char *name, const char *category, long long start,
+                     long long duration);
+  static void Counter(const char *name, double value);
+  template <class Mutex>
+  static void Lock(Mutex &mutex, const char *name) {
+    long long start = Now();
+    mutex.lock();
+    Record(name, "lock", start, Now() - start);
+  }
+
+  //  Call only while no traced thread is running
+  static bool WriteChromeJson(const std::string &path);
+  static void Clear();
+  static long long GetDropped();
+
+ private:
+  static TraceBuffer &Local_();
+};
+
+class ScopedTrace {
+ public:
+  explicit ScopedTrace(const char *name, const char *category = "phase")
+      : name_(name), category_(category), start_(Trace::Now()) {}
+  ~ScopedTrace() {
+    Trace::Record(name_, category_, start_, Trace::Now() - start_);
+  }
+  ScopedTrace(const ScopedTrace &) = delete;
+  ScopedTrace &operator=(const ScopedTrace &) = delete;
+
+ private:
+  const char *name_;
+  const char *category_;
+  long long start_;
+};
+}  // namespace s21
+
+#endif  // SRC_HELPERS_TRACE_H
@@ -27,7 +27,15 @@ void s21::Interface::Start() {
       std::cin >> file_address;
       std::ifstream file(file_address);
       if (file.is_open()) {
-        base_matrix_ = MatrixParser().LoadMatrixFromFile(file_address);
+        MatrixParser parser;
+#ifdef GAUSSALGORITHM
+        parser.LoadSystemFromFile(file_address, base_system_,
+                                  GaussAlgorithm::kSparseMinRows);
+        base_matrix_ = std::move(base_system_.dense);
+        base_structure_ = parser.GetStructure();
+#else
+        base_matrix_ = parser.LoadMatrixFromFile(file_address);
+#endif
       } else {
         error_ = true;
         Message_(WRONG_FILE);
@@ -80,22 +88,23 @@ void Interface::RunAntAlgorithm() {
     result_time[i] = duration.count();
   }
   GraphError error = algorithm.GetError();
-  if (error == GraphError::GRAPH_NORMAL || error == GraphError::GRAPH_DIRECT)
+  if (error == GraphError::GRAPH_NORMAL || error == GraphError::GRAPH_DIRECT) {
     PrintAntResult(result_time, result);
-  else
+    PrintPlacement_(4);
+  } else {
     Message_(WRONG_GRAPH);
+  }
 }
 
 void Interface::PrintAntResult(std::array<double, 2> &result_time,
                                std::array<TsmResult, 2> &result) {
   std::array<std::string, 2> sample = {"\nNo Parallels", "\nParallels"};
+  ResultWriter writer;
+  writer.SetSeparator(' ');
   for (unsigned int i = 0; i < sample.size(); ++i) {
-    std::cout << sample[i] << std::endl;
-    std::cout << "Distance " + std::to_string(result[i].distance) << std::endl
-              << "Path: ";
-    for (int j : result[i].vertices) {
-      std::cout << j << " ";
-    }
+    std::cout << sample[i] << "\nDistance "
+              << std::to_string(result[i].distance) << "\nPath: ";
+    writer.WriteVector(result[i].vertices);
     std::cout << std::endl
               << "Time: " << std::to_string(result_time[i]) << " sec\n";
   }
@@ -104,10 +113,14 @@ void Interface::PrintAntResult(std::array<double, 2> &result_time,
 
 #ifdef GAUSSALGORITHM
 void Interface::GaussAlgorithm() {
-  if (GaussAlgorithm::CheckGaussMatrix(base_matrix_)) {
+  if (base_system_.is_sparse) {
+    RunSparseGauss();
+  } else if (GaussAlgorithm::CheckGaussMatrix(base_matrix_)) {
     std::array<double, 2> times{};
+    MixedPrecisionResult mixed =
+        MixedPrecisionSolver().Solve(base_matrix_, true);
     std::vector<double> result =
-        GaussAlgorithm::GaussWithoutParallelism(base_matrix_);
+        GaussAlgorithm::GaussWithoutParallelism(base_matrix_, base_structure_);
 
     for (int t = 0; t < (int)times.max_size(); ++t) {
       auto start_time = std::chrono::high_resolution_clock::now();
@@ -119,23 +132,48 @@ void Interface::GaussAlgorithm() {
       times[t] = duration.count();
     }
     PrintResultGauss(result, times);
+    PrintMixedPrecision(mixed);
+    PrintPlacement_(GaussAlgorithm::GetNumberOfThreads(base_matrix_));
   } else {
     Message_("Error Wrong Matrix");
   }
 }
 
+//  The system never exists in dense form, so the parallel dense solver and
+//  the mixed precision one have nothing to work on
+void Interface::RunSparseGauss() {
+  std::vector<double> result = GaussAlgorithm::GaussSparse(
+      base_system_.coefficients, base_system_.right);
+  auto start_time = std::chrono::high_resolution_clock::now();
+  for (int i = 1; i < number_of_repeat_; ++i)
+    GaussAlgorithm::GaussSparse(base_system_.coefficients, base_system_.right);
+  std::chrono::duration<double> duration =
+      std::chrono::high_resolution_clock::now() - start_time;
+
+  Message_("Your result\n");
+  ResultWriter writer;
+  writer.SetPrecision(6);
+  writer.SetSeparator(' ');
+  writer.WriteVector(result);
+  Message_("\nDuration of the sparse solver\n Time: ");
+  std::cout << duration.count();
+}
+
 void Interface::ChoseThreadMode(bool mode) {
   if (mode)
-    GaussAlgorithm::GaussWithParallelism(base_matrix_);
+    GaussAlgorithm::GaussWithParallelism(base_matrix_, base_structure_);
   else
-    GaussAlgorithm::GaussWithoutParallelism(base_matrix_);
+    GaussAlgorithm::GaussWithoutParallelism(base_matrix_, base_structure_);
 }
 
 void Interface::PrintResultGauss(const std::vector<double> &result,
                                  std::array<double, 2> times) {
   Message_("Your result\n");
 
-  for (auto it : result) std::cout << it << " ";
+  ResultWriter writer;
+  writer.SetPrecision(6);
+  writer.SetSeparator(' ');
+  writer.WriteVector(result);
 
   Message_("\nDuration without Parallelism\n Time: ");
   std::cout << times[0];
@@ -143,12 +181,24 @@ void Interface::PrintResultGauss(const std::vector<double> &result,
   std::cout << times[1];
 }
 
+void Interface::PrintMixedPrecision(const MixedPrecisionResult &result) {
+  Message_("\nMixed precision (float LU + double refinement)\n Steps: ");
+  std::cout << result.refinement_steps;
+  if (result.fell_back) Message_(" (fell back to double)");
+  Message_("\n Backward error: ");
+  std::cout << result.residual;
+  Message_("\n Time: ");
+  std::cout << result.time;
+  Message_("\n Speedup over double LU: ");
+  std::cout << result.speedup << std::endl;
+}
+
 #endif
 
 #ifdef WINOGRADALGORITHM
 void Interface::RunWinogradAlgorithm() {
-  WinogradAlgorithm algorithm(base_matrix_, extra_matrix_for_winograd_,
-                              number_of_repeat_);
+  WinogradAlgorithm<double> algorithm(base_matrix_, extra_matrix_for_winograd_,
+                                      number_of_repeat_);
   std::array<double, 3> result_time{};
   std::array<Matrix<double>, 3> result_matrix{};
   for (unsigned int i = 0; i < result_matrix.size(); ++i) {
@@ -159,10 +209,47 @@ void Interface::RunWinogradAlgorithm() {
         std::chrono::high_resolution_clock::now() - start_time;
     result_time[i] = duration.count();
   }
-  if (!algorithm.GetError())
+  if (!algorithm.GetError()) {
     PrintWinogradResult(result_time, result_matrix);
-  else
+    PrintPlacement_(number_of_threads_);
+    PrintWinogradThroughput();
+  } else {
     Message_(WRONG_MATRIX);
+  }
+}
+
+void Interface::PrintWinogradThroughput() {
+  Message_("\nThroughput by type (classical parallelism)\n");
+  PrintTypeThroughput_<double>("double");
+  PrintTypeThroughput_<float>("float");
+  PrintTypeThroughput_<int>("int");
+}
+
+template <class T>
+void Interface::PrintTypeThroughput_(const std::string &type_name) {
+  WinogradAlgorithm<T> algorithm(ConvertMatrix_<T>(base_matrix_),
+                                 ConvertMatrix_<T>(extra_matrix_for_winograd_),
+                                 number_of_repeat_);
+  auto start_time = std::chrono::high_resolution_clock::now();
+  algorithm.GetResultMatrix(ExecutionType::CLASSICAL_PARALLELISM,
+                            number_of_threads_);
+  std::chrono::duration<double> duration =
+      std::chrono::high_resolution_clock::now() - start_time;
+  double operations = 2.0 * base_matrix_.GetRows() * base_matrix_.GetCols() *
+                      extra_matrix_for_winograd_.GetCols() * number_of_repeat_;
+  std::cout << type_name << ": " << operations / duration.count() / 1e9
+            << " Gop/s, time " << std::to_string(duration.count()) << " sec";
+  if (algorithm.GetOverflow()) std::cout << " (integer overflow)";
+  std::cout << std::endl;
+}
+
+template <class T>
+Matrix<T> Interface::ConvertMatrix_(Matrix<double> &matrix) {
+  Matrix<T> result(matrix.GetRows(), matrix.GetCols());
+  for (int i = 0; i < matrix.GetRows(); i++)
+    for (int j = 0; j < matrix.GetCols(); j++)
+      result(i, j) = static_cast<T>(matrix(i, j));
+  return result;
 }
 
 void Interface::PrintWinogradResult(std::array<double, 3> &result_time,
@@ -178,14 +265,23 @@ void Interface::PrintWinogradResult(std::array<double, 3> &result_time,
 }
 #endif
 
-void Interface::PrintMatrix_(Matrix<double> matrix) {
-  for (int i = 0; i < matrix.GetRows(); i++) {
-    for (int j = 0; j < matrix.GetCols(); j++) {
-      std::cout << matrix(i, j) << "\t";
-    }
-    std::cout << std::endl;
-  }
-  std::cout << std::endl;
+//  Precision 6 keeps the output of std::cout
+void Interface::PrintMatrix_(const Matrix<double> &matrix) {
+  ResultWriter writer;
+  writer.SetPrecision(6);
+  writer.WriteMatrix(matrix);
+  writer.WriteText("\n");
+}
+
+void Interface::PrintPlacement_(int number_of_thread) {
+  const Topology &topology = Topology::Get();
+  std::cout << "\nTopology: " << topology.GetPackageCount() << " sockets, "
+            << topology.GetCoreCount() << " cores, " << topology.GetCpuCount()
+            << " cpus, affinity "
+            << Topology::GetPolicyName(Topology::GetPolicy()) << std::endl
+            << "Placement: "
+            << topology.Describe(topology.Placement(number_of_thread))
+            << std::endl;
 }
 
 void Interface::Message_(const std::string &message) { std::cout << message; }
@@ -225,7 +321,7 @@ void Interface::RandomMatrix_(Matrix<double> &matrix) {
 }
 
 void Interface::SetNumberOfThreads() {
-  int tmp_max_threads = (int)std::thread::hardware_concurrency();
+  int tmp_max_threads = Topology::Get().GetMaxThreads();
   Message_(NUMBER_OF_THREADS);
   error_ = InputOptions_(number_of_threads_);
   if (number_of_threads_ > tmp_max_threads || number_of_threads_ < 1)
@@ -19,6 +19,7 @@
 
 #ifdef GAUSSALGORITHM
 #include "../algorithms/GaussAlgorithm.h"
+#include "../algorithms/MixedPrecisionSolver.h"
 #endif
 
 #ifdef WINOGRADALGORITHM
@@ -28,6 +29,8 @@
 #include <array>
 
 #include "../helpers/matrix_parser.h"
+#include "../helpers/result_writer.h"
+#include "../helpers/topology.h"
 
 namespace s21 {
 class Interface {
@@ -43,6 +46,11 @@ class Interface {
   int number_of_repeat_{};
   bool random_option = true;
 
+#ifdef GAUSSALGORITHM
+  MatrixStructure base_structure_;  //  of the file base_matrix_ came from
+  LinearSystem base_system_;        //  a large sparse file, instead of it
+#endif
+
 #ifdef WINOGRADALGORITHM
   Matrix<double> extra_matrix_for_winograd_;
   int number_of_threads_{};
@@ -51,7 +59,8 @@ class Interface {
   static void Message_(const std::string &message);
   static bool ThisStringIsDigit_(const std::string &example);
   static bool InputOptions_(int &options);
-  static void PrintMatrix_(Matrix<double> matrix);
+  static void PrintMatrix_(const Matrix<double> &matrix);
+  static void PrintPlacement_(int number_of_thread);
 
 #ifdef ANTALGORITHM
   void RunAntAlgorithm();
@@ -62,8 +71,10 @@ class Interface {
 #ifdef GAUSSALGORITHM
   void GaussAlgorithm();
   void ChoseThreadMode(bool mode);
+  void RunSparseGauss();
   static void PrintResultGauss(const std::vector<double> &result,
                                std::array<double, 2> times);
+  static void PrintMixedPrecision(const MixedPrecisionResult &result);
 #endif
 
 #ifdef WINOGRADALGORITHM
@@ -72,6 +83,11 @@ class Interface {
                                   std::array<Matrix<double>, 3> &result);
   static void RandomMatrix_(Matrix<double> &matrix);
   void SetNumberOfThreads();
+  void PrintWinogradThroughput();
+  template <class T>
+  void PrintTypeThroughput_(const std::string &type_name);
+  template <class T>
+  static Matrix<T> ConvertMatrix_(Matrix<double> &matrix);
 #endif
 };
 }  // namespace s21
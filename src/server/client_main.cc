@@ -0,0 +1,118 @@
+#include <csignal>
+#include <iostream>
+
+#include "../helpers/result_writer.h"
+#include "job_client.h"
+#include "job_server.h"
+
+namespace {
+void PrintUsage() {
+  std::cout << "Usage: s21_client [--socket PATH] [--threads N] "
+               "[--format text|binary] [--precision N] COMMAND\n"
+               "Commands:\n"
+               "  multiply FIRST SECOND\n"
+               "  solve SYSTEM\n"
+               "  tsp GRAPH\n"
+               "  stats\n"
+               "  shutdown\n"
+               "  matrix files are read by the server, paths should be "
+               "absolute\n"
+               "  binary output is MatrixParser's format, solutions as 1 x n "
+               "and tours as 1 x (n + 1) with the distance first\n"
+               "  precision 0 prints doubles that read back exactly\n";
+}
+
+bool PrintSolution(s21::ResultWriter &writer,
+                   const std::vector<double> &solution,
+                   s21::ResultFormat format) {
+  if (format == s21::BINARY_FORMAT) return writer.WriteVector(solution);
+  std::cout << "Solution: ";
+  return writer.WriteVector(solution) && writer.WriteText("\n");
+}
+
+bool PrintTour(s21::ResultWriter &writer, const s21::TsmResult &tour,
+               s21::ResultFormat format) {
+  if (format == s21::BINARY_FORMAT) {
+    std::vector<double> values = {tour.distance};
+    values.insert(values.end(), tour.vertices.begin(), tour.vertices.end());
+    return writer.WriteVector(values);
+  }
+  std::cout << "Distance: " << tour.distance << "\nPath: ";
+  return writer.WriteVector(tour.vertices) && writer.WriteText("\n");
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+  std::string socket_path = s21::JobServerOptions().socket_path;
+  int threads = 0, precision = 6, i = 1;
+  s21::ResultFormat format = s21::TEXT_FORMAT;
+  try {
+    for (; i + 1 < argc && argv[i][0] == '-'; i += 2) {
+      std::string key = argv[i];
+      if (key == "--socket") {
+        socket_path = argv[i + 1];
+      } else if (key == "--threads") {
+        threads = std::stoi(argv[i + 1]);
+      } else if (key == "--precision") {
+        precision = std::stoi(argv[i + 1]);
+        if (precision < 0) throw std::invalid_argument("precision");
+      } else if (key == "--format" && std::string(argv[i + 1]) == "text") {
+        format = s21::TEXT_FORMAT;
+      } else if (key == "--format" && std::string(argv[i + 1]) == "binary") {
+        format = s21::BINARY_FORMAT;
+      } else {
+        PrintUsage();
+        return 1;
+      }
+    }
+  } catch (std::exception &) {
+    std::cout << "Error! Wrong value for " << argv[i] << std::endl;
+    return 1;
+  }
+  if (i >= argc) {
+    PrintUsage();
+    return 1;
+  }
+  std::string command = argv[i];
+  int operands = argc - i - 1;
+
+  signal(SIGPIPE, SIG_IGN);
+  s21::JobClient client;
+  if (!client.Connect(socket_path)) {
+    std::cerr << "Error! " << client.GetError() << std::endl;
+    return 1;
+  }
+  s21::ResultWriter writer(STDOUT_FILENO, format);
+  writer.SetPrecision(precision);
+  bool done = false;
+  if (command == "multiply" && operands == 2) {
+    s21::Matrix<double> result;
+    done = client.Multiply(argv[i + 1], argv[i + 2], result, threads);
+    if (done) done = writer.WriteMatrix(result);
+  } else if (command == "solve" && operands == 1) {
+    std::vector<double> solution;
+    done = client.Solve(argv[i + 1], solution, threads);
+    writer.SetSeparator(' ');
+    if (done) done = PrintSolution(writer, solution, format);
+  } else if (command == "tsp" && operands == 1) {
+    s21::TsmResult tour;
+    done = client.Tsp(argv[i + 1], tour, threads);
+    writer.SetSeparator(' ');
+    if (done) done = PrintTour(writer, tour, format);
+  } else if (command == "stats" && operands == 0) {
+    std::string json;
+    done = client.Stats(json);
+    if (done) std::cout << json << std::endl;
+  } else if (command == "shutdown" && operands == 0) {
+    done = client.Shutdown();
+  } else {
+    PrintUsage();
+    return 1;
+  }
+  if (!done) {
+    const std::string &error = client.GetError().empty() ? writer.GetError()
+                                                         : client.GetError();
+    std::cerr << "Error! " << error << std::endl;
+  }
+  return done ? 0 : 1;
+}
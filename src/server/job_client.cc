@@ -0,0 +1,141 @@
+#include "job_client.h"
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+namespace s21 {
+
+JobClient::~JobClient() { Close(); }
+
+bool JobClient::Connect(const std::string &socket_path) {
+  Close();
+  sockaddr_un address{};
+  if (socket_path.size() >= sizeof(address.sun_path)) {
+    error_ = "socket path is too long";
+    return false;
+  }
+  address.sun_family = AF_UNIX;
+  std::strcpy(address.sun_path, socket_path.c_str());
+  fd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd_ < 0 || connect(fd_, reinterpret_cast<sockaddr *>(&address),
+                         sizeof(address)) < 0) {
+    error_ = "can't connect to " + socket_path + ": " + std::strerror(errno);
+    Close();
+    return false;
+  }
+  return true;
+}
+
+void JobClient::Close() {
+  if (fd_ >= 0) close(fd_);
+  fd_ = -1;
+}
+
+bool JobClient::Multiply(const JobOperand &first, const JobOperand &second,
+                         Matrix<double> &result, int threads) {
+  PayloadWriter writer;
+  PutOperand_(writer, first);
+  PutOperand_(writer, second);
+  writer.Put<int32_t>(threads);
+  std::string response;
+  if (!Call_(REQUEST_MULTIPLY, writer.GetData(), response)) return false;
+  PayloadReader reader(response);
+  if (!reader.GetMatrix(result)) {
+    error_ = "malformed response";
+    return false;
+  }
+  return true;
+}
+
+bool JobClient::Solve(const JobOperand &system, std::vector<double> &solution,
+                      int threads) {
+  PayloadWriter writer;
+  PutOperand_(writer, system);
+  writer.Put<int32_t>(threads);
+  std::string response;
+  if (!Call_(REQUEST_SOLVE, writer.GetData(), response)) return false;
+  PayloadReader reader(response);
+  uint32_t size = 0;
+  bool read = reader.Get(size);
+  solution.assign(read ? size : 0, 0);
+  for (uint32_t i = 0; read && i < size; ++i) read = reader.Get(solution[i]);
+  if (!read) error_ = "malformed response";
+  return read;
+}
+
+bool JobClient::Tsp(const JobOperand &graph, TsmResult &result, int threads) {
+  PayloadWriter writer;
+  PutOperand_(writer, graph);
+  writer.Put<int32_t>(threads);
+  std::string response;
+  if (!Call_(REQUEST_TSP, writer.GetData(), response)) return false;
+  PayloadReader reader(response);
+  uint32_t size = 0;
+  bool read = reader.Get(result.distance) && reader.Get(size);
+  result.vertices.assign(read ? size : 0, 0);
+  for (uint32_t i = 0; read && i < size; ++i) {
+    int32_t vertex = 0;
+    read = reader.Get(vertex);
+    result.vertices[i] = vertex;
+  }
+  if (!read) error_ = "malformed response";
+  return read;
+}
+
+bool JobClient::Stats(std::string &json) {
+  std::string response;
+  if (!Call_(REQUEST_STATS, "", response)) return false;
+  PayloadReader reader(response);
+  if (!reader.GetString(json)) {
+    error_ = "malformed response";
+    return false;
+  }
+  return true;
+}
+
+bool JobClient::Shutdown() {
+  std::string response;
+  return Call_(REQUEST_SHUTDOWN, "", response);
+}
+
+void JobClient::PutOperand_(PayloadWriter &writer, const JobOperand &operand) {
+  if (operand.matrix)
+    writer.PutInlineOperand(*operand.matrix);
+  else
+    writer.PutFileOperand(operand.path);
+}
+
+bool JobClient::Call_(uint16_t type, const std::string &payload,
+                      std::string &response) {
+  if (fd_ < 0) {
+    error_ = "not connected";
+    return false;
+  }
+  uint32_t id = next_id_++;
+  FrameHeader header;
+  if (!WriteFrame(fd_, type, id, payload) ||
+      !ReadFrame(fd_, header, response)) {
+    error_ = "connection to the server lost";
+    Close();
+    return false;
+  }
+  if (header.type != (type | kResponseFlag) || header.id != id ||
+      response.empty()) {
+    error_ = "malformed response";
+    return false;
+  }
+  PayloadReader reader(response);
+  uint8_t status = 0;
+  reader.Get(status);
+  if (status != 0) {
+    if (!reader.GetString(error_)) error_ = "malformed response";
+    return false;
+  }
+  response.erase(0, 1);
+  return true;
+}
+}  // namespace s21
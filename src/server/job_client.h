@@ -0,0 +1,56 @@
+#ifndef SRC_SERVER_JOB_CLIENT_H
+#define SRC_SERVER_JOB_CLIENT_H
+
+#include <string>
+#include <vector>
+
+#include "../algorithms/AntAlgorithm.h"
+#include "../helpers/matrix.h"
+#include "protocol.h"
+
+namespace s21 {
+
+//  A matrix sent along with the request, or the path of a matrix file the
+//  server reads (and caches) itself
+struct JobOperand {
+  JobOperand(const Matrix<double> &value) : matrix(&value) {}
+  JobOperand(std::string file) : path(std::move(file)) {}
+  JobOperand(const char *file) : path(file) {}
+  const Matrix<double> *matrix = nullptr;
+  std::string path;
+};
+
+//  Blocking client of JobServer, one request in flight per connection.
+//  Every call returns false with GetError() set if the server refused the
+//  job or the connection broke. threads 0 lets the server choose.
+class JobClient {
+ public:
+  JobClient() = default;
+  ~JobClient();
+  JobClient(const JobClient &) = delete;
+  JobClient &operator=(const JobClient &) = delete;
+
+  bool Connect(const std::string &socket_path);
+  void Close();
+  bool Multiply(const JobOperand &first, const JobOperand &second,
+                Matrix<double> &result, int threads = 0);
+  bool Solve(const JobOperand &system, std::vector<double> &solution,
+             int threads = 0);
+  bool Tsp(const JobOperand &graph, TsmResult &result, int threads = 0);
+  bool Stats(std::string &json);
+  bool Shutdown();
+  const std::string &GetError() const { return error_; }
+
+ private:
+  int fd_ = -1;
+  uint32_t next_id_ = 1;
+  std::string error_;
+
+  static void PutOperand_(PayloadWriter &writer, const JobOperand &operand);
+  //  response is what follows the status byte of a successful answer
+  bool Call_(uint16_t type, const std::string &payload,
+             std::string &response);
+};
+}  // namespace s21
+
+#endif  // SRC_SERVER_JOB_CLIENT_H
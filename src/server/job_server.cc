@@ -0,0 +1,556 @@
+#include "job_server.h"
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <csignal>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include "../helpers/topology.h"
+
+namespace s21 {
+namespace {
+const char *GetTypeName(uint16_t type) {
+  switch (type) {
+    case REQUEST_MULTIPLY:
+      return "multiply";
+    case REQUEST_SOLVE:
+      return "solve";
+    case REQUEST_TSP:
+      return "tsp";
+    case REQUEST_STATS:
+      return "stats";
+    default:
+      return "shutdown";
+  }
+}
+
+//  Nearest-rank, as in Benchmark::CalculateStatistics
+double Percentile(const std::vector<double> &sorted, double fraction) {
+  if (sorted.empty()) return 0;
+  int rank = (int)std::ceil(fraction * (double)sorted.size());
+  return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+//  A zero pivot leaves infinities or NaN in the solution
+bool IsFinite(const double *values, int count) {
+  return std::all_of(values, values + count,
+                     [](double value) { return std::isfinite(value); });
+}
+
+std::string OkPayload() {
+  PayloadWriter writer;
+  writer.Put<uint8_t>(0);
+  return writer.GetData();
+}
+}  // namespace
+
+JobServer::Connection::~Connection() {
+  if (fd >= 0) close(fd);
+}
+
+JobServer::JobServer(JobServerOptions options) : options_(std::move(options)) {
+  if (options_.workers <= 0)
+    options_.workers = Topology::Get().GetMaxThreads();
+  if (options_.batch_max < 1) options_.batch_max = 1;
+  if (options_.batch_window_us < 0) options_.batch_window_us = 0;
+}
+
+JobServer::~JobServer() { Stop(); }
+
+bool JobServer::Start() {
+  sockaddr_un address{};
+  if (options_.socket_path.size() >= sizeof(address.sun_path)) {
+    error_ = "socket path is too long";
+    return false;
+  }
+  //  A client that disconnects before its answer must not kill the server
+  signal(SIGPIPE, SIG_IGN);
+  address.sun_family = AF_UNIX;
+  std::strcpy(address.sun_path, options_.socket_path.c_str());
+  unlink(options_.socket_path.c_str());
+  listen_fd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (listen_fd_ < 0 ||
+      bind(listen_fd_, reinterpret_cast<sockaddr *>(&address),
+           sizeof(address)) < 0 ||
+      listen(listen_fd_, SOMAXCONN) < 0) {
+    error_ = "can't listen on " + options_.socket_path + ": " +
+             std::strerror(errno);
+    if (listen_fd_ >= 0) close(listen_fd_);
+    listen_fd_ = -1;
+    return false;
+  }
+  started_ = true;
+  std::vector<int> placement = Topology::Get().Placement(options_.workers);
+  for (int i = 0; i < options_.workers; ++i)
+    workers_.push_back(
+        Topology::StartThread(placement[i], &JobServer::WorkerLoop_, this));
+  accept_thread_ = std::thread(&JobServer::AcceptLoop_, this);
+  return true;
+}
+
+void JobServer::Wait() {
+  std::unique_lock<std::mutex> lock(stop_mutex_);
+  stop_cv_.wait(lock, [this] { return stop_requested_; });
+}
+
+void JobServer::RequestStop() {
+  std::lock_guard<std::mutex> lock(stop_mutex_);
+  stop_requested_ = true;
+  stop_cv_.notify_all();
+}
+
+//  Queued jobs are still run, their clients may already be gone
+void JobServer::Stop() {
+  if (!started_) return;
+  started_ = false;
+  RequestStop();
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    stopping_ = true;
+  }
+  queue_cv_.notify_all();
+  shutdown(listen_fd_, SHUT_RDWR);
+  if (accept_thread_.joinable()) accept_thread_.join();
+  close(listen_fd_);
+  listen_fd_ = -1;
+  {
+    std::lock_guard<std::mutex> lock(readers_mutex_);
+    for (auto &reader : readers_) shutdown(reader.second->fd, SHUT_RDWR);
+  }
+  for (auto &reader : readers_) reader.first.join();
+  readers_.clear();
+  for (std::thread &worker : workers_) worker.join();
+  workers_.clear();
+  unlink(options_.socket_path.c_str());
+}
+
+void JobServer::AcceptLoop_() {
+  while (!stopping_) {
+    int fd = accept(listen_fd_, nullptr, nullptr);
+    if (fd < 0) {
+      if (errno == EINTR || errno == ECONNABORTED) continue;
+      if (stopping_) break;
+      //  Out of descriptors, give the readers a moment to release some
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      continue;
+    }
+    auto connection = std::make_shared<Connection>(fd);
+    std::lock_guard<std::mutex> lock(readers_mutex_);
+    for (auto it = readers_.begin(); it != readers_.end();) {
+      if (it->second->closed) {
+        it->first.join();
+        it = readers_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    readers_.emplace_back(
+        std::thread(&JobServer::ReadLoop_, this, connection), connection);
+  }
+}
+
+void JobServer::ReadLoop_(std::shared_ptr<Connection> connection) {
+  FrameHeader header;
+  std::string payload;
+  while (!stopping_ && ReadFrame(connection->fd, header, payload)) {
+    auto job = std::make_shared<Job>();
+    job->type = header.type;
+    job->id = header.id;
+    job->connection = connection;
+    job->received = Clock::now();
+    if (header.type == REQUEST_STATS) {
+      PayloadWriter writer;
+      writer.Put<uint8_t>(0);
+      writer.PutString(GetStatsJson());
+      Respond_(*job, writer.GetData());
+      continue;
+    }
+    if (header.type == REQUEST_SHUTDOWN) {
+      Respond_(*job, OkPayload());
+      RequestStop();
+      continue;
+    }
+    std::string error;
+    if (!ParseJob_(header, payload, *job, error)) {
+      RespondError_(*job, error);
+      continue;
+    }
+    {
+      std::lock_guard<std::mutex> lock(queue_mutex_);
+      queue_.push_back(std::move(job));
+      max_queue_depth_ = std::max(max_queue_depth_, queue_.size());
+    }
+    queue_cv_.notify_one();
+  }
+  connection->closed = true;
+}
+
+bool JobServer::ParseJob_(const FrameHeader &header,
+                          const std::string &payload, Job &job,
+                          std::string &error) {
+  if (header.type != REQUEST_MULTIPLY && header.type != REQUEST_SOLVE &&
+      header.type != REQUEST_TSP) {
+    error = "unknown request type " + std::to_string(header.type);
+    return false;
+  }
+  PayloadReader reader(payload);
+  if (!ReadOperand_(reader, job.first, error)) return false;
+  if (header.type == REQUEST_MULTIPLY &&
+      !ReadOperand_(reader, job.second, error))
+    return false;
+  int32_t threads = 0;
+  if (!reader.Get(threads) || !reader.IsEmpty() || threads < 0) {
+    error = "malformed request";
+    return false;
+  }
+  job.threads = threads;
+  return true;
+}
+
+bool JobServer::ReadOperand_(PayloadReader &reader, Operand &operand,
+                             std::string &error) {
+  uint8_t kind = 0;
+  if (!reader.Get(kind)) {
+    error = "malformed request";
+    return false;
+  }
+  if (kind == OPERAND_INLINE) {
+    auto matrix = std::make_shared<Matrix<double>>();
+    if (!reader.GetMatrix(*matrix)) {
+      error = "malformed matrix";
+      return false;
+    }
+    operand = std::move(matrix);
+    return true;
+  }
+  std::string path;
+  if (kind != OPERAND_FILE || !reader.GetString(path)) {
+    error = "malformed request";
+    return false;
+  }
+  operand = LoadFile_(path, error);
+  return operand != nullptr;
+}
+
+//  Parsing happens outside the lock, two readers asking for the same new
+//  file at once both parse it and the second insert wins
+JobServer::Operand JobServer::LoadFile_(const std::string &path,
+                                        std::string &error) {
+  struct stat info {};
+  if (stat(path.c_str(), &info) != 0) {
+    error = "can't open " + path;
+    return nullptr;
+  }
+  long long mtime =
+      (long long)info.st_mtim.tv_sec * 1000000000LL + info.st_mtim.tv_nsec;
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    auto it = cache_.find(path);
+    if (it != cache_.end() && it->second.mtime == mtime) {
+      cache_order_.splice(cache_order_.begin(), cache_order_,
+                          it->second.position);
+      ++cache_hits_;
+      return it->second.matrix;
+    }
+  }
+  MatrixParser parser;
+  auto matrix =
+      std::make_shared<Matrix<double>>(parser.LoadMatrixFromFile(path));
+  if (parser.GetError() || matrix->GetRows() == 0) {
+    error = "can't parse " + path;
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  ++cache_misses_;
+  auto it = cache_.find(path);
+  if (it != cache_.end()) {
+    cache_used_ -= it->second.bytes;
+    cache_order_.erase(it->second.position);
+    cache_.erase(it);
+  }
+  CachedOperand &cached = cache_[path];
+  cached.matrix = matrix;
+  cached.mtime = mtime;
+  cached.bytes =
+      sizeof(double) * (std::size_t)matrix->GetRows() * matrix->GetCols();
+  cached.position = cache_order_.insert(cache_order_.begin(), path);
+  cache_used_ += cached.bytes;
+  //  The newest entry stays even if it alone is over the budget
+  while (cache_used_ > options_.cache_bytes && cache_order_.size() > 1) {
+    auto oldest = cache_.find(cache_order_.back());
+    cache_used_ -= oldest->second.bytes;
+    cache_.erase(oldest);
+    cache_order_.pop_back();
+  }
+  return matrix;
+}
+
+void JobServer::WorkerLoop_() {
+  while (true) {
+    std::shared_ptr<Job> job;
+    {
+      std::unique_lock<std::mutex> lock(queue_mutex_);
+      queue_cv_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+      if (queue_.empty()) return;
+      job = std::move(queue_.front());
+      queue_.pop_front();
+      busy_workers_++;
+    }
+    if (BatchKey_(*job).empty())
+      RunSingle_(*job);
+    else
+      RunBatch_(TakeBatch_(std::move(job)));
+    bool is_idle;
+    {
+      std::lock_guard<std::mutex> lock(queue_mutex_);
+      is_idle = --busy_workers_ == 0 && queue_.empty();
+    }
+    //  Blocks kept for reuse only pay off while jobs keep coming
+    if (is_idle) MatrixAllocator::ClearArena();
+  }
+}
+
+//  Jobs with equal keys can share one call of a batched kernel
+std::string JobServer::BatchKey_(const Job &job) const {
+  int limit = options_.batch_max_size;
+  if (job.type == REQUEST_MULTIPLY) {
+    int rows = job.first->GetRows(), inner = job.first->GetCols();
+    int cols = job.second->GetCols();
+    if (inner != job.second->GetRows() || rows > limit || inner > limit ||
+        cols > limit)
+      return "";
+    return "m" + std::to_string(rows) + "x" + std::to_string(inner) + "x" +
+           std::to_string(cols);
+  }
+  if (job.type == REQUEST_SOLVE) {
+    int size = job.first->GetRows();
+    if (job.first->GetCols() != size + 1 || size > limit) return "";
+    return "s" + std::to_string(size);
+  }
+  return "";
+}
+
+std::vector<std::shared_ptr<JobServer::Job>> JobServer::TakeBatch_(
+    std::shared_ptr<Job> first) {
+  std::string key = BatchKey_(*first);
+  std::vector<std::shared_ptr<Job>> batch{std::move(first)};
+  std::size_t limit = (std::size_t)options_.batch_max;
+  auto collect = [&] {
+    for (auto it = queue_.begin();
+         it != queue_.end() && batch.size() < limit;) {
+      if (BatchKey_(**it) == key) {
+        batch.push_back(std::move(*it));
+        it = queue_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  };
+  std::unique_lock<std::mutex> lock(queue_mutex_);
+  collect();
+  auto deadline =
+      Clock::now() + std::chrono::microseconds(options_.batch_window_us);
+  while (batch.size() < limit && !stopping_ &&
+         queue_cv_.wait_until(lock, deadline) == std::cv_status::no_timeout)
+    collect();
+  collect();
+  //  The wake-ups this worker consumed may have been meant for others
+  if (!queue_.empty()) queue_cv_.notify_one();
+  return batch;
+}
+
+void JobServer::RunBatch_(const std::vector<std::shared_ptr<Job>> &batch) {
+  if (batch.size() == 1) {
+    RunSingle_(*batch.front());
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    ++batches_;
+    batched_jobs_ += (long long)batch.size();
+  }
+  S21_TRACE_SCOPE("server batch");
+  if (batch.front()->type == REQUEST_MULTIPLY)
+    RunMultiplyBatch_(batch);
+  else
+    RunSolveBatch_(batch);
+}
+
+void JobServer::RunMultiplyBatch_(
+    const std::vector<std::shared_ptr<Job>> &batch) {
+  int rows = batch.front()->first->GetRows();
+  int inner = batch.front()->first->GetCols();
+  int cols = batch.front()->second->GetCols();
+  long first_size = (long)rows * inner, second_size = (long)inner * cols;
+  long result_size = (long)rows * cols;
+  int count = (int)batch.size();
+  std::vector<double> first(first_size * count), second(second_size * count);
+  std::vector<double> result(result_size * count);
+  for (int i = 0; i < count; ++i) {
+    for (int row = 0; row < rows; ++row)
+      std::copy_n(batch[i]->first->GetRow(row), inner,
+                  first.data() + first_size * i + (long)row * inner);
+    for (int row = 0; row < inner; ++row)
+      std::copy_n(batch[i]->second->GetRow(row), cols,
+                  second.data() + second_size * i + (long)row * cols);
+  }
+  WinogradBatch<double> kernel(rows, inner, cols);
+  kernel.Multiply({first.data(), first_size}, {second.data(), second_size},
+                  result.data(), result_size, count, 1);
+  for (int i = 0; i < count; ++i) {
+    if (kernel.GetError()) {
+      RespondError_(*batch[i], "incorrect matrix size");
+      continue;
+    }
+    PayloadWriter writer;
+    writer.Put<uint8_t>(0);
+    writer.Put<int32_t>(rows);
+    writer.Put<int32_t>(cols);
+    writer.PutDoubles(result.data() + result_size * i, result_size);
+    Respond_(*batch[i], writer.GetData());
+  }
+}
+
+void JobServer::RunSolveBatch_(const std::vector<std::shared_ptr<Job>> &batch) {
+  int size = batch.front()->first->GetRows();
+  long system_size = (long)size * (size + 1);
+  int count = (int)batch.size();
+  std::vector<double> systems(system_size * count), result((long)size * count);
+  for (int i = 0; i < count; ++i)
+    for (int row = 0; row < size; ++row)
+      std::copy_n(batch[i]->first->GetRow(row), size + 1,
+                  systems.data() + system_size * i + (long)row * (size + 1));
+  GaussBatch kernel(size);
+  kernel.Solve(systems.data(), system_size, result.data(), size, count, 1);
+  for (int i = 0; i < count; ++i) {
+    const double *solution = result.data() + (long)size * i;
+    if (kernel.GetError() || !IsFinite(solution, size)) {
+      RespondError_(*batch[i], "the system has no unique solution");
+      continue;
+    }
+    PayloadWriter writer;
+    writer.Put<uint8_t>(0);
+    writer.Put<uint32_t>((uint32_t)size);
+    writer.PutDoubles(solution, size);
+    Respond_(*batch[i], writer.GetData());
+  }
+}
+
+void JobServer::RunSingle_(const Job &job) {
+  S21_TRACE_SCOPE("server job");
+  PayloadWriter writer;
+  writer.Put<uint8_t>(0);
+  if (job.type == REQUEST_MULTIPLY) {
+    WinogradAlgorithm<double> algorithm(*job.first, *job.second);
+    Matrix<double> result = algorithm.GetResultMatrix(
+        job.threads > 1 ? CLASSICAL_PARALLELISM : WITHOUT_PARALLELISM,
+        job.threads);
+    if (algorithm.GetError())
+      return RespondError_(job, "incorrect matrix size");
+    writer.PutMatrix(result);
+  } else if (job.type == REQUEST_SOLVE) {
+    Matrix<double> system = *job.first;
+    if (!GaussAlgorithm::CheckGaussMatrix(system))
+      return RespondError_(job, "incorrect system of equations");
+    std::vector<double> solution =
+        job.threads > 1
+            ? GaussAlgorithm::GaussWithParallelism(system, job.threads)
+            : GaussAlgorithm::GaussWithoutParallelism(system);
+    if (solution.empty() || !IsFinite(solution.data(), (int)solution.size()))
+      return RespondError_(job, "the system has no unique solution");
+    writer.Put<uint32_t>((uint32_t)solution.size());
+    writer.PutDoubles(solution.data(), solution.size());
+  } else {
+    AntAlgorithm algorithm(*job.first, 1);
+    TsmResult tour = job.threads > 1
+                         ? algorithm.GetResultWithParallelism(job.threads)
+                         : algorithm.GetResult(false);
+    GraphError error = algorithm.GetError();
+    if (error == GRAPH_SMALL || error == GRAPH_INCOMPLETE)
+      return RespondError_(job,
+                           "graph can't be incomplete or smaller than 3x3");
+    writer.Put<double>(tour.distance);
+    writer.Put<uint32_t>((uint32_t)tour.vertices.size());
+    for (int vertex : tour.vertices) writer.Put<int32_t>(vertex);
+  }
+  Respond_(job, writer.GetData());
+}
+
+void JobServer::Respond_(const Job &job, const std::string &payload) {
+  Connection &connection = *job.connection;
+  if (!connection.closed) {
+    S21_TRACE_LOCK(connection.write_mutex, "server write");
+    std::lock_guard<std::mutex> lock(connection.write_mutex, std::adopt_lock);
+    WriteFrame(connection.fd, job.type | kResponseFlag, job.id, payload);
+  }
+  RecordLatency_(job);
+}
+
+void JobServer::RespondError_(const Job &job, const std::string &message) {
+  {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    ++failed_jobs_;
+  }
+  PayloadWriter writer;
+  writer.Put<uint8_t>(1);
+  writer.PutString(message);
+  Respond_(job, writer.GetData());
+}
+
+void JobServer::RecordLatency_(const Job &job) {
+  double micros = std::chrono::duration<double, std::micro>(Clock::now() -
+                                                            job.received)
+                      .count();
+  std::lock_guard<std::mutex> lock(stats_mutex_);
+  Latencies &latencies = latencies_[job.type];
+  if (latencies.samples.size() < (std::size_t)kLatencySamples)
+    latencies.samples.push_back(micros);
+  else
+    latencies.samples[latencies.next] = micros;
+  latencies.next = (latencies.next + 1) % kLatencySamples;
+  ++latencies.count;
+}
+
+//  Percentiles cover the last kLatencySamples jobs of each type
+std::string JobServer::GetStatsJson() {
+  std::ostringstream out;
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    out << "{\"queue_depth\": " << queue_.size()
+        << ", \"max_queue_depth\": " << max_queue_depth_;
+  }
+  out << ", \"workers\": " << options_.workers;
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    out << ", \"cache\": {\"entries\": " << cache_.size()
+        << ", \"bytes\": " << cache_used_ << ", \"hits\": " << cache_hits_
+        << ", \"misses\": " << cache_misses_ << "}";
+  }
+  std::lock_guard<std::mutex> lock(stats_mutex_);
+  out << ", \"batches\": " << batches_
+      << ", \"batched_jobs\": " << batched_jobs_
+      << ", \"failed_jobs\": " << failed_jobs_ << ", \"jobs\": {";
+  bool first = true;
+  for (const auto &entry : latencies_) {
+    std::vector<double> sorted = entry.second.samples;
+    std::sort(sorted.begin(), sorted.end());
+    out << (first ? "" : ", ") << "\"" << GetTypeName(entry.first)
+        << "\": {\"count\": " << entry.second.count
+        << ", \"p50_us\": " << Percentile(sorted, 0.5)
+        << ", \"p95_us\": " << Percentile(sorted, 0.95)
+        << ", \"p99_us\": " << Percentile(sorted, 0.99)
+        << ", \"max_us\": " << (sorted.empty() ? 0 : sorted.back()) << "}";
+    first = false;
+  }
+  out << "}}";
+  return out.str();
+}
+}  // namespace s21
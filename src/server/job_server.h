@@ -0,0 +1,150 @@
+#ifndef SRC_SERVER_JOB_SERVER_H
+#define SRC_SERVER_JOB_SERVER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../algorithms/AntAlgorithm.h"
+#include "../algorithms/GaussAlgorithm.h"
+#include "../algorithms/GaussBatch.h"
+#include "../algorithms/WinogradAlgorithm.h"
+#include "../algorithms/WinogradBatch.h"
+#include "../helpers/matrix.h"
+#include "../helpers/matrix_parser.h"
+#include "protocol.h"
+
+namespace s21 {
+
+struct JobServerOptions {
+  std::string socket_path = "/tmp/s21_jobs.sock";
+  int workers = 0;  //  0 takes Topology::GetMaxThreads()
+  //  A worker that picked a batchable job waits this long for more of the
+  //  same shape, 0 only takes what is queued already
+  int batch_window_us = 200;
+  int batch_max = 64;
+  //  Multiplications with every dimension and systems with at most this
+  //  many unknowns go through WinogradBatch / GaussBatch
+  int batch_max_size = 32;
+  std::size_t cache_bytes = (std::size_t)256 << 20;
+};
+
+//  Long-running server on a Unix domain socket, see protocol.h for the
+//  wire format. Each connection has a reader thread that decodes requests
+//  into a shared queue, a fixed pool of pinned workers runs them. Small
+//  multiplications and solves of one shape that are queued together go
+//  to the batched kernels in one call. Matrix files named in requests are
+//  parsed once and kept in an LRU cache keyed by path and mtime.
+class JobServer {
+ public:
+  explicit JobServer(JobServerOptions options);
+  ~JobServer();
+  JobServer(const JobServer &) = delete;
+  JobServer &operator=(const JobServer &) = delete;
+
+  //  false with GetError() set if the socket can't be bound
+  bool Start();
+  void Wait();         //  until RequestStop or a SHUTDOWN request
+  void RequestStop();  //  safe from any thread
+  void Stop();         //  closes everything and joins every thread
+  const std::string &GetError() const { return error_; }
+  std::string GetStatsJson();
+
+ private:
+  using Clock = std::chrono::steady_clock;
+  using Operand = std::shared_ptr<const Matrix<double>>;
+  static constexpr int kLatencySamples = 4096;
+
+  //  The descriptor is closed with the last reference, so a worker that
+  //  still holds a job of a dropped client never writes to a reused fd
+  struct Connection {
+    explicit Connection(int descriptor) : fd(descriptor) {}
+    ~Connection();
+    int fd;
+    std::mutex write_mutex;
+    std::atomic<bool> closed{false};
+  };
+
+  struct Job {
+    uint16_t type = 0;
+    uint32_t id = 0;
+    std::shared_ptr<Connection> connection;
+    Operand first, second;
+    int threads = 0;
+    Clock::time_point received;
+  };
+
+  struct Latencies {
+    std::vector<double> samples;  //  ring of the latest, microseconds
+    std::size_t next = 0;
+    long long count = 0;
+  };
+
+  struct CachedOperand {
+    Operand matrix;
+    long long mtime = 0;
+    std::size_t bytes = 0;
+    std::list<std::string>::iterator position;
+  };
+
+  JobServerOptions options_;
+  std::string error_;
+  int listen_fd_ = -1;
+  std::thread accept_thread_;
+  std::vector<std::thread> workers_;
+  std::list<std::pair<std::thread, std::shared_ptr<Connection>>> readers_;
+  std::mutex readers_mutex_;
+
+  std::mutex queue_mutex_;
+  std::condition_variable queue_cv_;
+  std::deque<std::shared_ptr<Job>> queue_;
+  int busy_workers_ = 0;  //  guarded by queue_mutex_
+  std::atomic<bool> stopping_{false};
+  bool started_ = false;
+  std::size_t max_queue_depth_ = 0;
+
+  std::mutex stop_mutex_;
+  std::condition_variable stop_cv_;
+  bool stop_requested_ = false;
+
+  std::mutex cache_mutex_;
+  std::map<std::string, CachedOperand> cache_;
+  std::list<std::string> cache_order_;  //  most recently used first
+  std::size_t cache_used_ = 0;
+
+  std::mutex stats_mutex_;
+  std::map<uint16_t, Latencies> latencies_;
+  long long batches_ = 0, batched_jobs_ = 0, failed_jobs_ = 0;
+  long long cache_hits_ = 0, cache_misses_ = 0;  //  under cache_mutex_
+
+  void AcceptLoop_();
+  void ReadLoop_(std::shared_ptr<Connection> connection);
+  void WorkerLoop_();
+  bool ParseJob_(const FrameHeader &header, const std::string &payload,
+                 Job &job, std::string &error);
+  bool ReadOperand_(PayloadReader &reader, Operand &operand,
+                    std::string &error);
+  Operand LoadFile_(const std::string &path, std::string &error);
+
+  std::string BatchKey_(const Job &job) const;
+  std::vector<std::shared_ptr<Job>> TakeBatch_(std::shared_ptr<Job> first);
+  void RunBatch_(const std::vector<std::shared_ptr<Job>> &batch);
+  void RunMultiplyBatch_(const std::vector<std::shared_ptr<Job>> &batch);
+  void RunSolveBatch_(const std::vector<std::shared_ptr<Job>> &batch);
+  void RunSingle_(const Job &job);
+
+  void Respond_(const Job &job, const std::string &payload);
+  void RespondError_(const Job &job, const std::string &message);
+  void RecordLatency_(const Job &job);
+};
+}  // namespace s21
+
+#endif  // SRC_SERVER_JOB_SERVER_H
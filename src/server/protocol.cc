@@ -0,0 +1,104 @@
+#include "protocol.h"
+
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <cerrno>
+
+namespace s21 {
+namespace {
+bool ReadExactly(int fd, char *data, size_t bytes) {
+  while (bytes > 0) {
+    ssize_t done = read(fd, data, bytes);
+    if (done < 0 && errno == EINTR) continue;
+    if (done <= 0) return false;
+    data += done;
+    bytes -= (size_t)done;
+  }
+  return true;
+}
+}  // namespace
+
+void PayloadWriter::PutString(const std::string &text) {
+  Put<uint32_t>((uint32_t)text.size());
+  data_ += text;
+}
+
+void PayloadWriter::PutDoubles(const double *values, std::size_t count) {
+  data_.append(reinterpret_cast<const char *>(values), sizeof(double) * count);
+}
+
+void PayloadWriter::PutMatrix(const Matrix<double> &matrix) {
+  Put<int32_t>(matrix.GetRows());
+  Put<int32_t>(matrix.GetCols());
+  for (int i = 0; i < matrix.GetRows(); ++i)
+    PutDoubles(matrix.GetRow(i), matrix.GetCols());
+}
+
+void PayloadWriter::PutInlineOperand(const Matrix<double> &matrix) {
+  Put<uint8_t>(OPERAND_INLINE);
+  PutMatrix(matrix);
+}
+
+void PayloadWriter::PutFileOperand(const std::string &path) {
+  Put<uint8_t>(OPERAND_FILE);
+  PutString(path);
+}
+
+bool PayloadReader::GetString(std::string &text) {
+  uint32_t size = 0;
+  if (!Get(size) || left_ < size) return false;
+  text.assign(data_, size);
+  data_ += size;
+  left_ -= size;
+  return true;
+}
+
+bool PayloadReader::GetMatrix(Matrix<double> &matrix) {
+  int32_t rows = 0, cols = 0;
+  if (!Get(rows) || !Get(cols) || rows < 1 || cols < 1) return false;
+  size_t row_bytes = sizeof(double) * (size_t)cols;
+  if (left_ / row_bytes < (size_t)rows) return false;
+  matrix = Matrix<double>(rows, cols);
+  for (int i = 0; i < rows; ++i) {
+    std::memcpy(matrix.GetRow(i), data_, row_bytes);
+    data_ += row_bytes;
+    left_ -= row_bytes;
+  }
+  return true;
+}
+
+bool ReadFrame(int fd, FrameHeader &header, std::string &payload) {
+  if (!ReadExactly(fd, reinterpret_cast<char *>(&header), sizeof(header)) ||
+      header.magic != kProtocolMagic || header.version != kProtocolVersion ||
+      header.bytes > kMaxPayload)
+    return false;
+  payload.resize(header.bytes);
+  return ReadExactly(fd, &payload[0], header.bytes);
+}
+
+//  Header and payload leave in one writev, MSG_NOSIGNAL is not available
+//  there so the server ignores SIGPIPE instead
+bool WriteFrame(int fd, uint16_t type, uint32_t id,
+                const std::string &payload) {
+  FrameHeader header;
+  header.type = type;
+  header.id = id;
+  header.bytes = (uint32_t)payload.size();
+  iovec parts[2] = {{&header, sizeof(header)},
+                    {const_cast<char *>(payload.data()), payload.size()}};
+  int first = 0;
+  while (first < 2) {
+    ssize_t done = writev(fd, parts + first, 2 - first);
+    if (done < 0 && errno == EINTR) continue;
+    if (done <= 0) return false;
+    for (; first < 2 && (size_t)done >= parts[first].iov_len; ++first)
+      done -= (ssize_t)parts[first].iov_len;
+    if (first < 2) {
+      parts[first].iov_base = static_cast<char *>(parts[first].iov_base) + done;
+      parts[first].iov_len -= (size_t)done;
+    }
+  }
+  return true;
+}
+}  // namespace s21
@@ -0,0 +1,103 @@
+#ifndef SRC_SERVER_PROTOCOL_H
+#define SRC_SERVER_PROTOCOL_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "../helpers/matrix.h"
+
+namespace s21 {
+
+//  Every message is a FrameHeader followed by bytes of payload, integers
+//  and doubles in the byte order of the host since both ends share it.
+//  A response carries the type of its request with kResponseFlag set, the
+//  same id, and a payload starting with a status byte, 0 for success,
+//  otherwise followed by an error string.
+//
+//  Payloads of requests:
+//    MULTIPLY  operand first, operand second, int32 threads
+//    SOLVE     operand system (n x n + 1), int32 threads
+//    TSP       operand graph, int32 threads
+//    STATS, SHUTDOWN  empty
+//  An operand is a uint8 OperandKind and then either int32 rows, int32
+//  cols and rows * cols doubles, or a string naming a matrix file on the
+//  server. Strings are uint32 length and bytes. threads 0 leaves the
+//  choice to the server.
+//  Payloads of successful responses:
+//    MULTIPLY  int32 rows, int32 cols, doubles
+//    SOLVE     uint32 n, n doubles
+//    TSP       double distance, uint32 n, n int32 vertices
+//    STATS     string with a JSON object
+constexpr uint32_t kProtocolMagic = 0x4A313253;  //  "S21J"
+constexpr uint16_t kProtocolVersion = 1;
+constexpr uint16_t kResponseFlag = 0x8000;
+constexpr uint32_t kMaxPayload = 1u << 30;
+
+enum RequestType : uint16_t {
+  REQUEST_MULTIPLY = 1,
+  REQUEST_SOLVE,
+  REQUEST_TSP,
+  REQUEST_STATS,
+  REQUEST_SHUTDOWN
+};
+
+enum OperandKind : uint8_t { OPERAND_INLINE, OPERAND_FILE };
+
+struct FrameHeader {
+  uint32_t magic = kProtocolMagic;
+  uint16_t version = kProtocolVersion;
+  uint16_t type = 0;
+  uint32_t id = 0;
+  uint32_t bytes = 0;
+};
+
+class PayloadWriter {
+ public:
+  template <class T>
+  void Put(T value) {
+    data_.append(reinterpret_cast<const char *>(&value), sizeof(T));
+  }
+  void PutString(const std::string &text);
+  void PutDoubles(const double *values, std::size_t count);
+  void PutMatrix(const Matrix<double> &matrix);
+  void PutInlineOperand(const Matrix<double> &matrix);
+  void PutFileOperand(const std::string &path);
+  const std::string &GetData() const { return data_; }
+
+ private:
+  std::string data_;
+};
+
+//  Every Get fails instead of reading past the end of the payload
+class PayloadReader {
+ public:
+  explicit PayloadReader(const std::string &data)
+      : data_(data.data()), left_(data.size()) {}
+
+  template <class T>
+  bool Get(T &value) {
+    if (left_ < sizeof(T)) return false;
+    std::memcpy(&value, data_, sizeof(T));
+    data_ += sizeof(T);
+    left_ -= sizeof(T);
+    return true;
+  }
+  bool GetString(std::string &text);
+  bool GetMatrix(Matrix<double> &matrix);
+  bool IsEmpty() const { return left_ == 0; }
+
+ private:
+  const char *data_;
+  size_t left_;
+};
+
+//  Blocking, retried on EINTR and short transfers. false once the peer
+//  is gone or the header is malformed.
+bool ReadFrame(int fd, FrameHeader &header, std::string &payload);
+bool WriteFrame(int fd, uint16_t type, uint32_t id,
+                const std::string &payload);
+}  // namespace s21
+
+#endif  // SRC_SERVER_PROTOCOL_H
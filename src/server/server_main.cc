@@ -0,0 +1,88 @@
+#include <pthread.h>
+
+#include <csignal>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+
+#include "../helpers/topology.h"
+#include "job_server.h"
+
+namespace {
+void PrintUsage() {
+  std::cout << "Usage: s21_server [--socket PATH] [--workers N] "
+               "[--batch-window-us N]\n"
+               "                  [--batch-max N] [--batch-max-size N] "
+               "[--cache-mb N]\n"
+               "                  [--affinity none|compact|scatter|cores]\n"
+               "                  [--allocation default|arena|thp|hugetlb|"
+               "first-touch=N,...]\n";
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+  s21::JobServerOptions options;
+  for (int i = 1; i < argc; ++i) {
+    std::string key = argv[i];
+    if (key == "--help" || i + 1 >= argc) {
+      PrintUsage();
+      return key == "--help" ? 0 : 1;
+    }
+    std::string value = argv[++i];
+    try {
+      if (key == "--socket") {
+        options.socket_path = value;
+      } else if (key == "--workers") {
+        options.workers = std::stoi(value);
+      } else if (key == "--batch-window-us") {
+        options.batch_window_us = std::stoi(value);
+      } else if (key == "--batch-max") {
+        options.batch_max = std::stoi(value);
+      } else if (key == "--batch-max-size") {
+        options.batch_max_size = std::stoi(value);
+      } else if (key == "--cache-mb") {
+        options.cache_bytes = (std::size_t)std::stoul(value) << 20;
+      } else if (key == "--affinity") {
+        s21::AffinityPolicy policy;
+        if (!s21::Topology::ParsePolicy(value, policy))
+          throw std::invalid_argument(key);
+        s21::Topology::SetPolicy(policy);
+      } else if (key == "--allocation") {
+        s21::AllocationPolicy policy;
+        if (!s21::MatrixAllocator::ParsePolicy(value, policy))
+          throw std::invalid_argument(key);
+        s21::MatrixAllocator::SetDefaultPolicy(policy);
+      } else {
+        PrintUsage();
+        return 1;
+      }
+    } catch (std::exception &) {
+      std::cout << "Error! Wrong value for " << key << std::endl;
+      return 1;
+    }
+  }
+
+  //  Blocked before any thread starts so only the waiter below sees them
+  sigset_t signals;
+  sigemptyset(&signals);
+  sigaddset(&signals, SIGINT);
+  sigaddset(&signals, SIGTERM);
+  pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+  s21::JobServer server(options);
+  if (!server.Start()) {
+    std::cerr << "Error! " << server.GetError() << std::endl;
+    return 1;
+  }
+  std::thread waiter([&] {
+    int signal = 0;
+    sigwait(&signals, &signal);
+    server.RequestStop();
+  });
+  waiter.detach();
+  std::cerr << "Listening on " << options.socket_path << std::endl;
+  server.Wait();
+  server.Stop();
+  std::cout << server.GetStatsJson() << std::endl;
+  return 0;
+}